@@ -0,0 +1,96 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+
+namespace tfsc
+{
+
+/// Destination of the words of a SPIR-V binary written by WriteToBinary
+/// Words are handed over in order, in chunks of arbitrary size.
+class BinarySink
+{
+    public:
+    virtual ~BinarySink() = default;
+
+    /// Consume the next words of the binary
+    /// @param[in] words pointer to the first word
+    /// @param[in] wordCount number of words
+    virtual void Write(const uint32_t* words, std::size_t wordCount) = 0;
+};
+
+/// BinarySink writing into a caller-provided buffer, e.g. one sized with the expected binary size
+class BufferSink final : public BinarySink
+{
+    public:
+    /// Constructor for BufferSink
+    /// @param[in] buffer pointer to the first word of the buffer
+    /// @param[in] capacity size of the buffer in words
+    BufferSink(uint32_t* buffer, std::size_t capacity);
+
+    /// @throws std::runtime_error if the words do not fit in the remaining capacity of the buffer
+    void Write(const uint32_t* words, std::size_t wordCount) override;
+
+    /// @return number of words written to the buffer so far
+    std::size_t GetWordCount() const { return m_WordCount; }
+
+    private:
+    uint32_t* m_Buffer;
+    std::size_t m_Capacity;
+    std::size_t m_WordCount = 0;
+};
+
+/// BinarySink writing the words as raw bytes, in host byte order, to an output stream
+class StreamSink final : public BinarySink
+{
+    public:
+    /// Constructor for StreamSink
+    /// @param[in] stream output stream, which must outlive the StreamSink
+    explicit StreamSink(std::ostream& stream);
+
+    /// @throws std::runtime_error if the stream fails
+    void Write(const uint32_t* words, std::size_t wordCount) override;
+
+    private:
+    std::ostream& m_Stream;
+};
+
+/// BinarySink writing the words as raw bytes, in host byte order, to a file descriptor
+class FileDescriptorSink final : public BinarySink
+{
+    public:
+    /// Constructor for FileDescriptorSink
+    /// @param[in] fileDescriptor open file descriptor, which is not closed by the FileDescriptorSink
+    explicit FileDescriptorSink(int fileDescriptor);
+
+    /// @throws std::runtime_error if writing to the file descriptor fails
+    void Write(const uint32_t* words, std::size_t wordCount) override;
+
+    private:
+    int m_FileDescriptor;
+};
+
+/// BinarySink forwarding the words to a user callback
+class CallbackSink final : public BinarySink
+{
+    public:
+    using Callback = std::function<void(const uint32_t* words, std::size_t wordCount)>;
+
+    /// Constructor for CallbackSink
+    /// @param[in] callback function called with each chunk of words
+    explicit CallbackSink(Callback callback);
+
+    void Write(const uint32_t* words, std::size_t wordCount) override;
+
+    private:
+    Callback m_Callback;
+};
+
+} // namespace tfsc
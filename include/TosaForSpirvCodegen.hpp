@@ -6,15 +6,22 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace tfsc
 {
 
+class BinarySink;
+
 namespace spirv
 {
+class Instruction;
 class Module;
+struct ModuleOptions;
+struct FrozenModule;
 }
 
 /// Enum class to specify different TOSA versions.
@@ -31,9 +38,104 @@ enum class TOSAVersion
 /// @return shared pointer of the Module
 std::shared_ptr<spirv::Module> CreateModule(TOSAVersion version);
 
+/// Factory function creating a tosa_for_spirv_codegen Module with the given construction options
+/// @param[in] version version of TOSA
+/// @param[in] options Module construction options, e.g. to allocate the Module from an arena
+/// @return shared pointer of the Module
+std::shared_ptr<spirv::Module> CreateModule(TOSAVersion version, const spirv::ModuleOptions& options);
+
+/// Options of the SPIR-V binary writer
+struct BinaryWriterOptions
+{
+    /// Number of threads encoding the Instructions, 0 selects the hardware concurrency.
+    /// The output is identical whatever the number of threads.
+    unsigned int m_ThreadCount = 1;
+    /// Minimum number of Instructions encoded by each thread, so small Modules are not split
+    std::size_t m_MinInstructionsPerThread = 16 * 1024;
+    /// Renumber the result ids densely in the order they are written, so the bound in the header is tight.
+    /// Ids of Instructions that are not written, e.g. unused constants, are dropped from the numbering.
+    bool m_CompactResIds = false;
+};
+
 /// Write the Module to a binary representation of spirv
 /// @param module the spirv Module
 /// @return uint32_t binary spirv vector
 std::vector<uint32_t> WriteToBinary(const std::shared_ptr<spirv::Module>& module);
 
+/// Write the Module to a binary representation of spirv, with the given writer options
+/// Once the order of the Instructions is fixed, contiguous ranges of them are encoded in parallel straight into
+/// their final position in the binary.
+/// @param module the spirv Module
+/// @param options writer options, e.g. the number of threads
+/// @return uint32_t binary spirv vector
+std::vector<uint32_t> WriteToBinary(const std::shared_ptr<spirv::Module>& module, const BinaryWriterOptions& options);
+
+/// Write the Module to a binary representation of spirv, streaming the words into a sink
+/// The words are produced in the same order as the vector returned by WriteToBinary(module, options), and the
+/// header, including the bound, is written first. At most a small fixed-size chunk of words is buffered at a time.
+/// @param module the spirv Module
+/// @param sink destination of the binary, see BinarySink.hpp
+/// @param options writer options, the binary is always encoded by the calling thread
+void WriteToBinary(const std::shared_ptr<spirv::Module>& module,
+                   BinarySink& sink,
+                   const BinaryWriterOptions& options = BinaryWriterOptions{});
+
+/// Write a frozen Module to a binary representation of spirv, see spirv::Module::Freeze
+/// The binary is identical to the one WriteToBinary(module) produces for the Module the view was frozen from,
+/// and is encoded with a single linear scan of the view.
+/// @param module the frozen spirv Module
+/// @return uint32_t binary spirv vector
+std::vector<uint32_t> WriteToBinary(const spirv::FrozenModule& module);
+
+/// Get the exact size of the binary WriteToBinary produces for the Module, e.g. to pre-size a buffer for a BufferSink
+/// The size is computed by ordering the Instructions as the writer does, without encoding them.
+/// @param module the spirv Module
+/// @return size of the binary in uint32_t words
+std::size_t GetBinarySizeInWords(const std::shared_ptr<spirv::Module>& module);
+
+/// Summary of the Instructions removed by EliminateDeadInstructions
+struct DeadInstructionReport
+{
+    /// Number of Instructions removed from the Module
+    std::size_t m_RemovedInstructions = 0;
+    /// Number of bytes the binary shrinks by, removed Instructions the writer never emitted are not counted
+    std::size_t m_SavedBytes = 0;
+};
+
+/// Remove the Instructions the graph does not depend on from the Module, e.g. operators whose results are never
+/// consumed by a graph output and the constants and types only they used.
+/// Instructions reachable from the module header, the graph interface and the graph outputs are kept, as are the
+/// decorations of kept Instructions. The result ids of the kept Instructions are unchanged, set
+/// BinaryWriterOptions::m_CompactResIds to also close the gaps left in the numbering.
+/// Operands referring to a removed Instruction, e.g. ResIds still held by a Graph, must not be used afterwards.
+/// @param module the spirv Module
+/// @return Number of Instructions removed and bytes saved from the binary
+DeadInstructionReport EliminateDeadInstructions(const std::shared_ptr<spirv::Module>& module);
+
+/// Outcome of LinkModules
+struct LinkResult
+{
+    /// Instruction of the destination Module each Instruction of the source Module was linked to,
+    /// e.g. to translate the tosa::ResIds of the source into ResIds of the destination
+    std::unordered_map<const spirv::Instruction*, const spirv::Instruction*> m_Instructions;
+    /// Number of Instructions added to the destination, the others were already present
+    std::size_t m_ImportedInstructions = 0;
+    /// Offset added to the ids of the OpGraphConstantARMs of the source
+    uint32_t m_GraphConstantOffset = 0;
+    /// Id following the highest OpGraphConstantARM id of the destination after linking
+    uint32_t m_NextGraphConstantId = 0;
+};
+
+/// Import the Instructions of the source Module into the destination Module, e.g. to combine parts of a network built
+/// in separate Modules on separate threads. Instructions are emplaced into the destination, so types, constants and
+/// any other Instruction both Modules contain are stored once. Operands referring to Instructions are redirected to
+/// the destination's Instructions and the imported Instructions are given destination ResIds.
+/// OpGraphConstantARM ids of the source are offset past those of the destination, so the ids of the external constants
+/// stay unique, and the destination allocates the ids of later graph constants after them.
+/// Graphs finalized in the source become additional graphs of the destination. The source Module is left unchanged.
+/// @param destination the spirv Module to link into
+/// @param source the spirv Module to import, which must not be the destination
+/// @return Mapping from source to destination Instructions and the OpGraphConstantARM id offset
+LinkResult LinkModules(const std::shared_ptr<spirv::Module>& destination, const std::shared_ptr<spirv::Module>& source);
+
 } // namespace tfsc
\ No newline at end of file
@@ -0,0 +1,56 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include "Operand.hpp"
+
+#include <spirv/unified1/spirv.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// tosa-for-spirv-codegen's shorthand namespace
+namespace tfsc::spirv
+{
+
+/// Read-only, flat copy of a Module in emission order, see Module::Freeze
+/// Instructions are stored as a structure of arrays indexed by their position in the emission order, and operands
+/// refer to other Instructions by index rather than by pointer, so consumers can walk the Module with linear scans.
+/// The view owns all of its data and stays valid after the Module is modified or destroyed.
+struct FrozenModule
+{
+    /// Opcode of each Instruction
+    std::vector<spv::Op> m_Opcodes;
+    /// Number of words of each Instruction in the binary, including the opcode word
+    std::vector<uint32_t> m_WordCounts;
+    /// Result id of each Instruction, 0 for Instructions without one
+    std::vector<uint32_t> m_ResIds;
+    /// The operands of Instruction idx are at [m_OperandOffsets[idx], m_OperandOffsets[idx + 1]) in m_OperandTypes
+    /// and m_OperandValues, which holds one more offset than there are Instructions
+    std::vector<uint32_t> m_OperandOffsets{0};
+    /// Type of each operand
+    std::vector<OperandType> m_OperandTypes;
+    /// Value of each operand, by type:
+    /// LITERAL_WORD: the word
+    /// INSTRUCTION_POINTER: index of the Instruction pointed to
+    /// RES_ID: index of the Instruction holding the operand
+    /// LITERAL_STRING: index of the string
+    /// UNINITIALIZED: 0
+    std::vector<uint32_t> m_OperandValues;
+    /// The padded, null-terminated encoding of string idx is at [m_StringOffsets[idx], m_StringOffsets[idx + 1])
+    /// in m_StringWords, which holds one more offset than there are strings
+    std::vector<uint32_t> m_StringOffsets{0};
+    /// Encoded words of all strings, each distinct string is stored once
+    std::vector<uint32_t> m_StringWords;
+    /// Bound of the result ids, as written in the header of the binary
+    uint32_t m_ResIdBound = 1;
+
+    /// Get the number of Instructions
+    std::size_t GetInstructionCount() const { return m_Opcodes.size(); }
+};
+
+} // namespace tfsc::spirv
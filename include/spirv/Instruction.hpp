@@ -9,50 +9,132 @@
 
 #include <spirv/unified1/spirv.hpp>
 
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
 #include <vector>
 
 // tosa-for-spirv-codegen's shorthand namespace
 namespace tfsc::spirv
 {
 /// tosa-for-spirv-codegen's implementation of SPIR-V Instruction.
-class Instruction
+/// Aligned to 8 bytes so that Operands can keep their type in the low bits of an Instruction pointer.
+class alignas(8) Instruction
 {
     public:
+    using OperandVector = std::pmr::vector<Operand>;
+
     Instruction() = default;
-    Instruction(const spv::Op opCode, const std::vector<Operand>& operands)
-        : m_Opcode(opCode)
-        , m_Operands(operands)
+
+    /// Construct an Instruction, copying the operands into storage obtained from the given memory resource
+    /// @param[in] opCode opcode of the Instruction
+    /// @param[in] operands pointer to the first operand
+    /// @param[in] operandCount number of operands
+    /// @param[in] resource memory resource the operand array is allocated from
+    Instruction(const spv::Op opCode,
+                const Operand* operands,
+                const std::size_t operandCount,
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : Instruction(opCode, operands, operandCount, ComputeHash(opCode, operands, operandCount), resource)
     {
-        for (const Operand& operand : m_Operands)
-        {
-            m_WordCount += operand.WordSize();
-        }
     }
 
-    Instruction(const spv::Op opCode, std::vector<Operand>&& operands)
+    /// Construct an Instruction whose structural hash has already been computed, e.g. by a failed Module lookup
+    /// @param[in] opCode opcode of the Instruction
+    /// @param[in] operands pointer to the first operand
+    /// @param[in] operandCount number of operands
+    /// @param[in] hash InstructionHash of opCode and operands
+    /// @param[in] resource memory resource the operand array is allocated from
+    Instruction(const spv::Op opCode,
+                const Operand* operands,
+                const std::size_t operandCount,
+                const std::size_t hash,
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource())
         : m_Opcode(opCode)
-        , m_Operands(std::move(operands))
+        , m_Hash(hash)
+        , m_Operands(operands, operands + operandCount, resource)
     {
-        for (const Operand& operand : m_Operands)
+        for (uint32_t idx = 0; idx < m_Operands.size(); ++idx)
         {
+            const Operand& operand = m_Operands[idx];
             m_WordCount += operand.WordSize();
+            if (operand.GetType() == RES_ID && m_ResIdPosition == NoResIdPosition)
+            {
+                m_ResId = operand.GetLiteralWord();
+                m_ResIdPosition = idx;
+            }
         }
     }
 
+    Instruction(const spv::Op opCode, const std::vector<Operand>& operands)
+        : Instruction(opCode, operands.data(), operands.size())
+    {
+    }
+
+    Instruction(const spv::Op opCode, std::initializer_list<Operand> operands)
+        : Instruction(opCode, operands.begin(), operands.size())
+    {
+    }
+
     /// Getter for m_Opcode.
     /// @return spv::Op
     spv::Op GetOpCode() const { return m_Opcode; }
 
+    /// Getter for m_ResId.
+    /// @return uint32_t result id, 0 if the Instruction has no RES_ID Operand
+    uint32_t GetResId() const { return m_ResId; }
+
+    /// Getter for m_Hash.
+    /// Debug builds check that m_Operands was not edited since the hash was computed.
+    /// @return std::size_t structural hash of the Instruction, see InstructionHash
+    std::size_t GetHash() const
+    {
+        assert(m_Hash == ComputeHash(m_Opcode, m_Operands.data(), m_Operands.size()) &&
+               "m_Operands was edited after the Instruction was constructed");
+        return m_Hash;
+    }
+
+    /// @return true if the Instruction has a RES_ID Operand
+    bool HasResId() const { return m_ResIdPosition != NoResIdPosition; }
+
+    /// Set the result id of the Instruction, updating its RES_ID Operand
+    /// @param[in] resId result id
+    void SetResId(const uint32_t resId)
+    {
+        if (HasResId())
+        {
+            m_ResId = resId;
+            m_Operands[m_ResIdPosition] = Operand{resId, RES_ID};
+        }
+    }
+
+    /// Value of m_ResIdPosition for Instructions without a RES_ID Operand
+    static constexpr uint32_t NoResIdPosition = UINT32_MAX;
+
     /// m_Opcode denotes instruction type
     spv::Op m_Opcode{};
     /// m_WordCount is the total size of the Instruction in uint32_t words
     uint32_t m_WordCount{1};
+    /// m_ResId is the value of the first RES_ID Operand, cached on construction and kept in sync by SetResId
+    uint32_t m_ResId{0};
+    /// m_ResIdPosition is the index of the first RES_ID Operand in m_Operands
+    uint32_t m_ResIdPosition{NoResIdPosition};
+    /// m_Hash is the structural hash of the Instruction, cached on construction
+    /// RES_ID values do not contribute, so SetResId keeps it valid. Editing m_Operands directly does not,
+    /// an Instruction edited that way must not be hashed, compared with InstructionEqual or emplaced
+    std::size_t m_Hash{0};
     /// m_Operands are the operands can constitute the Instruction
-    std::vector<Operand> m_Operands;
+    OperandVector m_Operands;
+
+    private:
+    static std::size_t ComputeHash(spv::Op opCode, const Operand* operands, std::size_t operandCount) noexcept;
 };
 
 /// Custom Instruction comparator, used to sort Instructions and define when an Instruction is unique
 /// Also enables partial sorts of the Instructions by opCode
+/// The order is by opcode, then operand count, then operands from last to first. WriteToBinary lays out the binary
+/// in this order, so it does not use the cached hash: ordering by hash would change the binary.
 struct InstructionComparator
 {
     // mark comparator as transparent, allowing for equal range search
@@ -62,4 +144,27 @@ struct InstructionComparator
     bool operator()(const Instruction& lhs, const Instruction& rhs) const noexcept;
 };
 
+/// Structural hash of an Instruction, used by the Module to deduplicate Instructions
+/// The values of RES_ID Operands are ignored so an Instruction hashes the same before and after its ResId is assigned
+struct InstructionHash
+{
+    /// Returns the hash cached on the Instruction when it was constructed
+    std::size_t operator()(const Instruction& instruction) const noexcept;
+    /// Hash an Instruction that has not been materialised, given its opcode and operands
+    std::size_t operator()(spv::Op opCode, const Operand* operands, std::size_t operandCount) const noexcept;
+};
+
+/// Structural equality of two Instructions, matching the equivalence defined by InstructionComparator
+/// The values of RES_ID Operands are ignored. Instructions with different cached hashes compare unequal without
+/// looking at their operands.
+struct InstructionEqual
+{
+    bool operator()(const Instruction& lhs, const Instruction& rhs) const noexcept;
+    /// Compare an Instruction with one that has not been materialised, given its opcode and operands
+    bool operator()(const Instruction& lhs,
+                    spv::Op opCode,
+                    const Operand* operands,
+                    std::size_t operandCount) const noexcept;
+};
+
 } // namespace tfsc::spirv
\ No newline at end of file
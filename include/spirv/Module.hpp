@@ -5,73 +5,607 @@
 
 #pragma once
 
+#include "FrozenModule.hpp"
 #include "Instruction.hpp"
 
 #include <algorithm>
-#include <set>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 // tosa-for-spirv-codegen's shorthand namespace
 namespace tfsc::spirv
 {
+/// Construction options of a Module
+struct ModuleOptions
+{
+    /// Allocate Instructions, their operand arrays and the deduplication table from an arena owned by the Module.
+    /// Memory is bump-allocated from large chunks and released in one go when the Module is destroyed,
+    /// trading a higher peak footprint for far fewer heap allocations.
+    bool m_UseArena = false;
+    /// Size in bytes of the first arena chunk, subsequent chunks grow geometrically
+    std::size_t m_ArenaChunkSize = 64 * 1024;
+    /// Maintain the users of each Instruction as Instructions are emplaced, so Module::GetUsers can find the
+    /// consumers of a result without scanning the Module
+    bool m_TrackUses = false;
+    /// Allow Instructions and strings to be emplaced from several threads at once, e.g. by several Graphs or by
+    /// several threads sharing a Graph. Lookups only lock the shard of the deduplication table the Instruction
+    /// hashes to, and ResIds are allocated atomically, so the ResIds and the order of the Instructions depend on
+    /// how the threads interleave.
+    bool m_Concurrent = false;
+    /// Number of independently locked shards of the deduplication table of a concurrent Module, rounded up to a
+    /// power of two
+    std::size_t m_ShardCount = 64;
+    /// Number of slots of the direct-mapped type cache, rounded up to a power of two, 0 disables the cache.
+    /// See Module::FindCachedType.
+    std::size_t m_TypeCacheSize = 256;
+};
+
+/// Hit and miss counts of the type cache of a Module, see Module::FindCachedType
+struct TypeCacheStats
+{
+    std::size_t m_Hits = 0;
+    std::size_t m_Misses = 0;
+
+    /// Get the fraction of lookups that hit
+    /// @return hits divided by lookups, 0 if there were no lookups
+    double GetHitRate() const
+    {
+        const auto lookups = m_Hits + m_Misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(m_Hits) / static_cast<double>(lookups);
+    }
+};
+
+/// Opcode and operands of an Instruction to emplace, see Module::EmplaceInstructions
+struct InstructionDescriptor
+{
+    spv::Op m_Opcode;
+    /// Pointer to the first operand, the operands are only read during the emplacement
+    const Operand* m_Operands;
+    std::size_t m_OperandCount;
+};
+
+/// Instructions delimiting one graph of a Module and its interface, recorded by tosa::Graph::FinalizeGraph
+/// A Module can hold several graphs sharing its types and constants; the writer emits the body of each graph,
+/// the operators depending on its inputs or its outputs depend on, between its OpGraphARM and its OpGraphEndARM.
+/// An unused operator computed from constants only is written in the first graph finalized after it was emplaced.
+/// An operator that belongs to several graphs cannot be written.
+struct GraphDefinition
+{
+    /// OpGraphARM of the graph
+    const Instruction* m_Graph = nullptr;
+    /// OpGraphInputARM of each input of the graph
+    std::vector<const Instruction*> m_Inputs;
+    /// OpGraphSetOutputARM of each output of the graph
+    std::vector<const Instruction*> m_Outputs;
+    /// OpGraphEndARM of the graph
+    const Instruction* m_End = nullptr;
+};
+
+class ModuleArena;
+
 /// tosa-for-spirv-codegen's implementation of SPIR-V module.
+/// Instructions are hash-consed: each Instruction is stored once, in a node with a stable address,
+/// and indexed by its structural hash so that duplicates are found in expected constant time.
+/// Instructions and strings are stored in layers: a Module emplaces into a layer of its own, and shares the older
+/// layers, which never change again, with the Modules forked from the same Module, see Fork.
+/// A Module is not thread-safe unless created with ModuleOptions::m_Concurrent, which makes the emplacement
+/// functions safe to call concurrently. Every other member function must still not run concurrently with them.
 class Module
 {
     public:
+    Module()
+        : Module(ModuleOptions{})
+    {
+    }
+
+    /// Module constructor
+    /// @param[in] options construction options of the Module
+    explicit Module(const ModuleOptions& options);
+
+    ~Module();
+
+    /// Pre-size the Module for the given number of Instructions, operands and strings still to be emplaced
+    /// The deduplication table, the interning table and the use index are sized so they do not rehash or
+    /// reallocate while the Module grows by those amounts. An arena Module also sets aside a single chunk large
+    /// enough for the new Instructions, their operand arrays and their table nodes.
+    /// The counts are hints: emplacing more or fewer is allowed.
+    /// @param[in] instructionCount number of Instructions
+    /// @param[in] operandCount total number of operands of those Instructions
+    /// @param[in] stringCount number of distinct strings
+    void Reserve(std::size_t instructionCount, std::size_t operandCount = 0, std::size_t stringCount = 0);
+
     /// Conditionally emplace an Instruction into the SPIR-V module
-    /// Function moves the given operands into an Instruction and adds it to the module if
-    /// no matching function is found within the Module
+    /// Function looks up the given opcode and operands within the Module and only creates a new Instruction,
+    /// copying the operands into it, if no matching Instruction is found.
+    /// No memory is allocated when a matching Instruction already exists.
     /// The ResId of an Instruction will only be assigned once it has been successfully placed into the Module
-    /// The operands vector is moved and must not be reused after this call.
     /// @param[in] opCode opcode of the Instruction
-    /// @param[in] operands operands of the instruction, ownership is moved.
+    /// @param[in] operands pointer to the first operand of the instruction
+    /// @param[in] operandCount number of operands
     /// @return An operand pointing to either the newly created Instruction or
     /// to a matching Instruction already existing in the Module
-    Operand EmplaceInstruction(spv::Op opCode, std::vector<Operand> operands);
+    Operand EmplaceInstruction(spv::Op opCode, const Operand* operands, std::size_t operandCount);
+
+    /// Conditionally emplace an Instruction into the SPIR-V module
+    /// Preferred overload for braced lists of operands, which are only copied on a lookup miss.
+    /// @param[in] opCode opcode of the Instruction
+    /// @param[in] operands operands of the instruction
+    /// @return An operand pointing to either the newly created Instruction or
+    /// to a matching Instruction already existing in the Module
+    Operand EmplaceInstruction(spv::Op opCode, std::initializer_list<Operand> operands)
+    {
+        return EmplaceInstruction(opCode, operands.begin(), operands.size());
+    }
+
+    /// Conditionally emplace an Instruction into the SPIR-V module
+    /// The operands are only copied on a lookup miss.
+    /// @param[in] opCode opcode of the Instruction
+    /// @param[in] operands operands of the instruction
+    /// @return An operand pointing to either the newly created Instruction or
+    /// to a matching Instruction already existing in the Module
+    Operand EmplaceInstruction(spv::Op opCode, const std::vector<Operand>& operands)
+    {
+        return EmplaceInstruction(opCode, operands.data(), operands.size());
+    }
 
     /// Emplace an Instruction into the SPIR-V module
-    /// Function will always create a new Instruction in the Module, moving the provided operands into it.
-    /// The operands vector is moved and must not be reused after this call.
+    /// Function will always create a new Instruction in the Module, copying the provided operands into it.
     /// @param[in] opCode opcode of the Instruction
-    /// @param[in] operands operands of the instruction, ownership is moved.
+    /// @param[in] operands operands of the instruction
     /// @return An operand pointing the newly created Instruction
-    Operand EmplaceInstructionNonUnique(spv::Op opCode, std::vector<Operand> operands);
+    Operand EmplaceInstructionNonUnique(spv::Op opCode, const std::vector<Operand>& operands);
+
+    /// Conditionally emplace a batch of Instructions into the SPIR-V module
+    /// Equivalent to calling EmplaceInstruction on each descriptor, but the whole batch is hashed before any lock is
+    /// taken, the tables and the arena are sized for it once, and the batch is inserted shard by shard, taking the
+    /// locks of each shard and of the Instruction list once. A Module that is not concurrent has a single shard, so
+    /// ResIds are assigned in descriptor order as by EmplaceInstruction; a concurrent Module assigns them shard by
+    /// shard. Duplicates within the batch yield the same Operand. The operands of a descriptor can only refer to
+    /// Instructions already in the Module, not to the results of the same batch.
+    /// @param[in] descriptors pointer to the first descriptor of the batch
+    /// @param[in] count number of descriptors
+    /// @param[out] results pointer to the first of count Operands, set to the Instruction matching each descriptor
+    void EmplaceInstructions(const InstructionDescriptor* descriptors, std::size_t count, Operand* results);
+
+    /// Conditionally emplace a batch of Instructions into the SPIR-V module
+    /// @param[in] descriptors descriptors of the Instructions, see EmplaceInstructions(descriptors, count, results)
+    /// @return An operand pointing to the Instruction matching each descriptor
+    std::vector<Operand> EmplaceInstructions(const std::vector<InstructionDescriptor>& descriptors)
+    {
+        std::vector<Operand> results(descriptors.size());
+        EmplaceInstructions(descriptors.data(), descriptors.size(), results.data());
+        return results;
+    }
+
+    /// Emplace a string into the SPIR-V module, to be referred to by LITERAL_STRING Operands
+    /// Strings are interned: the Module owns a single copy of each distinct string, which stays valid for the
+    /// lifetime of the Module, so equal strings emplaced into the same Module yield identical Operands. The copy and
+    /// its SPIR-V encoding are allocated from the Module's memory resource, i.e. from the arena of an arena Module.
+    /// @param[in] str string value
+    /// @return A LITERAL_STRING operand referring to the Module's copy of the string
+    Operand EmplaceString(std::string_view str);
+
+    using InstructionList = std::pmr::list<Instruction>;
+
+    /// Forward iterator over Instructions of a Module, visiting those of each layer in turn, oldest layer first
+    /// Iterators stay valid when the Module is forked, and until the Instructions they refer to are erased.
+    class InstructionIterator
+    {
+        public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Instruction;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Instruction*;
+        using reference = const Instruction&;
+
+        InstructionIterator() = default;
+
+        reference operator*() const { return *m_It; }
+        pointer operator->() const { return &(*m_It); }
+
+        InstructionIterator& operator++()
+        {
+            if (++m_It == m_End)
+            {
+                SeekLayer(m_Layer + 1);
+            }
+            return *this;
+        }
+
+        InstructionIterator operator++(int)
+        {
+            auto previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const InstructionIterator& other) const
+        {
+            return m_Layer == other.m_Layer && m_It == other.m_It;
+        }
+        bool operator!=(const InstructionIterator& other) const { return !(*this == other); }
+
+        private:
+        friend class Module;
+
+        /// Move to the first visited Instruction of the given layer or of the next one holding any, or to the end
+        /// @param[in] layer index of the layer in Module::m_Layers
+        void SeekLayer(std::size_t layer);
+
+        const Module* m_Module = nullptr;
+        /// Index of the current layer, m_LayerCount once past the last Instruction
+        std::size_t m_Layer = 0;
+        /// Number of layers of the Module when the iterator was created, the last one being the Module's own
+        std::size_t m_LayerCount = 0;
+        /// Opcode of the visited Instructions, every Instruction is visited if m_AllOpcodes is set
+        spv::Op m_Opcode = spv::OpNop;
+        bool m_AllOpcodes = false;
+        /// Current Instruction and end of the visited Instructions of the current layer
+        InstructionList::const_iterator m_It;
+        InstructionList::const_iterator m_End;
+        /// Visited Instructions of the Module's own layer, taken when the iterator was created so that iterating
+        /// does not read the own layer while other threads emplace into it
+        InstructionList::const_iterator m_OwnBegin;
+        InstructionList::const_iterator m_OwnEnd;
+    };
 
-    using InstructionIterator = std::multiset<Instruction, InstructionComparator>::const_iterator;
     using InstructionRange = std::pair<InstructionIterator, InstructionIterator>;
 
+    /// All Instructions of a Module, see GetSpirvGraph
+    class InstructionView
+    {
+        public:
+        InstructionIterator begin() const { return m_Begin; }
+        InstructionIterator end() const { return m_End; }
+        const Instruction& front() const { return *m_Begin; }
+        std::size_t size() const { return m_Size; }
+        bool empty() const { return m_Size == 0; }
+
+        private:
+        friend class Module;
+
+        InstructionIterator m_Begin;
+        InstructionIterator m_End;
+        std::size_t m_Size = 0;
+    };
+
+    /// Get the bound of the result ids assigned by the Module
+    /// @return uint32_t one greater than the largest result id assigned so far
+    uint32_t GetResIdBound() const { return m_ResId.load(std::memory_order_relaxed); }
+
+    /// Allocate the id of a new OpGraphConstantARM
+    /// Ids are unique across the Module, so graphs sharing a Module never bind two constants to the same id.
+    /// @return uint32_t graph constant id
+    uint32_t AllocateGraphConstantId() { return m_GraphConstantId.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Get the bound of the graph constant ids allocated by the Module
+    /// @return uint32_t one greater than the largest graph constant id allocated so far
+    uint32_t GetGraphConstantIdBound() const { return m_GraphConstantId.load(std::memory_order_relaxed); }
+
+    /// Allocate graph constant ids from at least the given bound, e.g. after OpGraphConstantARMs were imported
+    /// @param[in] bound graph constant id bound
+    void ReserveGraphConstantIds(uint32_t bound);
+
     /// Get all Instructions of a given opCode from the Module
+    /// Instructions of the same opCode are kept adjacent within each layer, in the order they were emplaced.
+    /// The range of each layer is looked up in constant time from its per-opCode index.
+    /// In a concurrent Module the range does not include Instructions emplaced after the call.
     /// @param opCode opCode to match
     /// @return An iterator range of those Instructions
-    InstructionRange GetInstructionsOfType(const spv::Op opCode) const
-    {
-        auto begin = m_SPIRVGraph.begin();
-        auto end = m_SPIRVGraph.end();
+    InstructionRange GetInstructionsOfType(spv::Op opCode) const;
+
+    /// Get spirv graph, containing all Instructions in the module, layer by layer
+    /// @return A view of the Instructions, whose size is taken when it is created
+    InstructionView GetSpirvGraph() const;
+
+    /// Record a graph defined by Instructions of the Module, see GraphDefinition
+    /// @param[in] definition Instructions of the graph, owned by the Module
+    void AddGraphDefinition(GraphDefinition definition) { m_Graphs.push_back(std::move(definition)); }
+
+    /// Get the graphs recorded in the Module, in the order they were finalized
+    const std::vector<GraphDefinition>& GetGraphDefinitions() const { return m_Graphs; }
+
+    using UserList = std::pmr::vector<const Instruction*>;
+
+    /// Whether the Module maintains the users of its Instructions, see ModuleOptions::m_TrackUses
+    bool TracksUses() const { return m_TrackUses; }
 
-        // Find the first instruction with a matching opcode
-        auto lower = std::find_if(begin, end, [&](const Instruction& instr) { return instr.GetOpCode() == opCode; });
+    /// Get the Instructions using the result of an Instruction through an INSTRUCTION_POINTER Operand
+    /// Each user is listed once, in the order the users were emplaced. Only Instructions with a ResId have users.
+    /// Throws std::runtime_error unless the Module was created with ModuleOptions::m_TrackUses.
+    /// @param[in] definition Instruction owned by the Module
+    /// @return Users of the Instruction, valid until the next Instruction is emplaced into or erased from the Module
+    const UserList& GetUsers(const Instruction& definition) const;
 
-        if (lower == end)
+    /// Copy the Module into a flat, read-only view in emission order
+    /// The view holds the Instructions WriteToBinary would write, in the same order and with the same result ids,
+    /// and does not change when the Module does. Freeze is meant for Modules that are complete, e.g. once
+    /// Graph::FinalizeGraph has been called, as the view has to be created again after any change.
+    /// Throws std::runtime_error if a written Instruction refers to an Instruction that is not written.
+    /// @return The frozen view of the Module
+    FrozenModule Freeze() const;
+
+    /// Remove all Instructions matching a predicate from the Module
+    /// The opcode groups and the deduplication table are kept consistent, and the ResIds of the remaining
+    /// Instructions are left unchanged. The caller must ensure no remaining Instruction refers to a removed one;
+    /// Operands pointing to a removed Instruction are left dangling.
+    /// Only the Instructions of the Module's own layer are considered: Instructions emplaced before the Module was
+    /// forked, or inherited by a fork, are shared and never removed.
+    /// @param[in] predicate returns true for each Instruction to remove
+    /// @return Number of Instructions removed
+    std::size_t EraseInstructionsIf(const std::function<bool(const Instruction&)>& predicate);
+
+    /// Look a type up in the Module's type cache, e.g. the tensor type of a data type and shape
+    /// The cache is direct-mapped: each key maps to a single slot, so a key evicts the previous occupant of its slot.
+    /// A miss is only ever a missed shortcut: callers emplace the type as usual and add it with CacheType, the
+    /// deduplication table still guarantees each type is stored once.
+    /// @param[in] tag caller-defined kind of the key, e.g. a data type
+    /// @param[in] words pointer to the first word of the rest of the key, e.g. a shape
+    /// @param[in] wordCount number of words, keys of more than TypeCacheKeyWords words are never cached
+    /// @return The cached Instruction, nullptr on a miss or if the cache is disabled
+    const Instruction* FindCachedType(uint32_t tag, const uint32_t* words, std::size_t wordCount);
+
+    /// Add a type to the Module's type cache, see FindCachedType
+    /// @param[in] tag caller-defined kind of the key
+    /// @param[in] words pointer to the first word of the rest of the key
+    /// @param[in] wordCount number of words
+    /// @param[in] type Instruction owned by the Module
+    void CacheType(uint32_t tag, const uint32_t* words, std::size_t wordCount, const Instruction* type);
+
+    /// Get the hit and miss counts of the type cache since the Module was created
+    TypeCacheStats GetTypeCacheStats() const;
+
+    /// Maximum number of words, besides the tag, of a type cache key, enough for the shape of any TOSA tensor
+    static constexpr std::size_t TypeCacheKeyWords = 8;
+
+    /// Look a scalar constant up in the Module's constant pool, e.g. by data type and value
+    /// Unlike the type cache the pool keeps every constant added to it. Values below SmallConstantCount under a tag
+    /// below SmallConstantTagCount are looked up directly in a table, the others with a single probe sequence of a
+    /// small open-addressing hash table.
+    /// @param[in] tag caller-defined kind of the constant, e.g. a data type
+    /// @param[in] value value of the constant
+    /// @return The pooled Instruction, nullptr if the constant was not added to the pool
+    const Instruction* FindPooledConstant(uint32_t tag, uint32_t value) const;
+
+    /// Add a scalar constant to the Module's constant pool, see FindPooledConstant
+    /// @param[in] tag caller-defined kind of the constant
+    /// @param[in] value value of the constant
+    /// @param[in] constant Instruction owned by the Module
+    void PoolConstant(uint32_t tag, uint32_t value, const Instruction* constant);
+
+    /// Values of the constants the constant pool finds without hashing
+    static constexpr uint32_t SmallConstantCount = 256;
+    /// Tags of the constants the constant pool finds without hashing
+    static constexpr uint32_t SmallConstantTagCount = 64;
+
+    /// Fork the Module, e.g. to complete several variants of a partly built network side by side
+    /// Forking takes constant time: the Module's own layer is sealed and shared read-only by the Module and the fork,
+    /// and each of them emplaces into a new layer of its own from then on. Lookups search the shared layers too, so
+    /// the fork reuses every Instruction and string emplaced so far and only stores those it adds. ResIds, graph
+    /// constant ids and graph definitions carry on from those of this Module, separately in each Module, so a
+    /// variant gets the same binary as one built from scratch. Operands of this Module remain valid in the fork.
+    /// The fork has the options of this Module, starts with an empty type cache and constant pool, and keeps the
+    /// shared layers, and the arena they were allocated from, alive. A Module tracking uses sizes the use index of
+    /// its own layer to the ResId bound on its first use and copies the users of a shared Instruction when it first
+    /// adds one.
+    /// Must not run concurrently with any other member function.
+    /// @return The forked Module
+    std::shared_ptr<Module> Fork();
+
+    private:
+    using InstructionTable = std::pmr::unordered_multimap<std::size_t, const Instruction*>;
+
+    /// Part of the hash-consing table, holding the Instructions whose hashes map to it
+    struct InstructionShard
+    {
+        explicit InstructionShard(std::pmr::memory_resource* resource)
+            : m_Table(resource)
         {
-            // No matching instruction found
-            return {end, end};
         }
 
-        // Finds the first instruction after the matching block (with a different opcode)
-        auto upper = std::find_if(lower, end, [&](const Instruction& instr) { return instr.GetOpCode() != opCode; });
+        /// Guards m_Table in concurrent Modules
+        std::mutex m_Mutex;
+        InstructionTable m_Table;
+    };
 
-        // Returns a range of all instructions with the given opcode
-        return {lower, upper};
+    /// First and last Instruction of a group of Instructions sharing an opcode
+    struct OpcodeGroup
+    {
+        InstructionList::iterator m_First;
+        InstructionList::iterator m_Last;
+    };
+
+    /// Instructions and strings emplaced into a Module between two forks, see Fork
+    /// The last layer of a Module is its own. The others are sealed: they never change again, so they are read
+    /// without locking, and are shared with the Modules forked from the same Module.
+    struct Layer
+    {
+        Layer(std::shared_ptr<ModuleArena> arena, std::pmr::memory_resource* resource, std::size_t shardCount);
+
+        /// Get the shard of the hash-consing table an Instruction belongs to
+        /// @param[in] hash structural hash of the Instruction
+        InstructionShard& GetShard(std::size_t hash) const { return *m_Shards[hash & (m_Shards.size() - 1)]; }
+
+        /// Get the Instructions of the layer with the given opcode, or all of them
+        /// @param[in] opCode opcode to match
+        /// @param[in] allOpcodes whether to get all Instructions
+        /// @return An iterator range of those Instructions
+        std::pair<InstructionList::const_iterator, InstructionList::const_iterator> GetRange(spv::Op opCode,
+                                                                                            bool allOpcodes) const;
+
+        /// Arena the containers of the layer allocate from, kept alive as long as the layer
+        std::shared_ptr<ModuleArena> m_Arena;
+        /// Instructions grouped by opcode. List nodes are never relocated, so ResIds stay valid.
+        InstructionList m_SPIRVGraph;
+        /// Per-opcode index of the groups in m_SPIRVGraph, new Instructions of an opcode are inserted after its last
+        std::unordered_map<spv::Op, OpcodeGroup> m_OpcodeGroups;
+        /// Hash-consing table, keyed by the structural hash computed once when an Instruction is emplaced.
+        /// Split into a power of two number of shards by the low bits of the hash, a single one unless concurrent.
+        std::vector<std::unique_ptr<InstructionShard>> m_Shards;
+        /// Payloads of LITERAL_STRING Operands, list nodes are never relocated so Operands stay valid.
+        /// Each LiteralString allocates its string and encoding from the memory resource of the layer.
+        std::pmr::list<LiteralString> m_Strings;
+        /// Interning table of m_Strings, keyed by views of the stored strings
+        std::pmr::unordered_map<std::string_view, const LiteralString*> m_StringTable;
+        /// Reverse use-def index, the users of each Instruction indexed by its ResId. A non-empty list also holds
+        /// the users the older layers list, so the newest layer listing users of an Instruction lists all of them.
+        std::pmr::vector<UserList> m_Users;
+    };
+
+    /// Lock a mutex of the Module if it is concurrent
+    /// @param[in] mutex mutex to lock
+    /// @return A lock owning the mutex in a concurrent Module, otherwise an empty lock
+    std::unique_lock<std::mutex> Lock(std::mutex& mutex) const
+    {
+        return m_Concurrent ? std::unique_lock<std::mutex>(mutex) : std::unique_lock<std::mutex>();
     }
 
-    /// Get spirv graph, containing all Instructions in the module
-    const std::multiset<Instruction, InstructionComparator>& GetSpirvGraph() const { return m_SPIRVGraph; }
+    /// Find an Instruction structurally equal to the given opcode and operands
+    /// @param[in] shard shard of the hash-consing table the Instruction belongs to, locked by the caller
+    /// @param[in] opCode opcode to match
+    /// @param[in] operands pointer to the first operand to match
+    /// @param[in] operandCount number of operands
+    /// @param[in] hash structural hash of the opcode and operands
+    /// @return Pointer to the matching Instruction or nullptr if none exists
+    const Instruction* FindInstruction(const InstructionShard& shard,
+                                       spv::Op opCode,
+                                       const Operand* operands,
+                                       std::size_t operandCount,
+                                       std::size_t hash) const;
 
-    private:
-    uint32_t m_ResId = 1;
-    std::multiset<Instruction, InstructionComparator> m_SPIRVGraph;
+    /// Find an Instruction structurally equal to the given opcode and operands in the sealed layers, see Fork
+    /// @param[in] opCode opcode to match
+    /// @param[in] operands pointer to the first operand to match
+    /// @param[in] operandCount number of operands
+    /// @param[in] hash structural hash of the opcode and operands
+    /// @return Pointer to the matching Instruction or nullptr if none exists
+    const Instruction* FindSharedInstruction(spv::Op opCode,
+                                             const Operand* operands,
+                                             std::size_t operandCount,
+                                             std::size_t hash) const;
+
+    /// Find the users of an Instruction listed by the newest of the given layers listing any, see Layer::m_Users
+    /// @param[in] layerCount number of layers to search, from the oldest
+    /// @param[in] resId ResId of the Instruction
+    /// @return The users, nullptr if no layer lists any
+    const UserList* FindUsers(std::size_t layerCount, uint32_t resId) const;
+
+    /// Get an iterator to the first Instruction of the Module with the given opcode, or to the first of them all
+    /// @param[in] opCode opcode to match
+    /// @param[in] allOpcodes whether to visit all Instructions
+    InstructionIterator GetBeginIterator(spv::Op opCode, bool allOpcodes) const;
+
+    /// Get an iterator past the last Instruction of the Module
+    InstructionIterator GetEndIterator() const;
+
+    /// Slot of the type cache, see FindCachedType
+    /// The key words are stored inline, so replacing the occupant of a slot never allocates
+    struct TypeCacheSlot
+    {
+        std::size_t m_Hash = 0;
+        uint32_t m_Tag = 0;
+        uint32_t m_WordCount = 0;
+        std::array<uint32_t, TypeCacheKeyWords> m_Words{};
+        /// Cached Instruction, nullptr for an empty slot
+        const Instruction* m_Type = nullptr;
+    };
+
+    /// Slot of the open-addressing constant pool, see FindPooledConstant
+    struct ConstantPoolSlot
+    {
+        uint32_t m_Tag = 0;
+        uint32_t m_Value = 0;
+        /// Pooled Instruction, nullptr for an empty slot
+        const Instruction* m_Constant = nullptr;
+    };
+
+    /// Get the first slot of the probe sequence of a constant in the constant pool
+    std::size_t GetConstantPoolSlot(uint32_t tag, uint32_t value) const;
+
+    /// Empty the type cache and the constant pool, e.g. when Instructions they may refer to are erased
+    void ClearCaches();
+
+    /// Hash a type cache key
+    static std::size_t HashTypeKey(uint32_t tag, const uint32_t* words, std::size_t wordCount);
+
+    /// Remove Instructions from the Module, keeping the opcode groups, the deduplication table and the use index
+    /// consistent, see EraseInstructionsIf
+    /// @param[in] erased Instructions to remove
+    void EraseInstructions(const std::vector<InstructionList::iterator>& erased);
+
+    /// Assign a ResId to the Instruction, then move it into the Module and index it by its hash
+    /// @param[in] shard shard of the hash-consing table the Instruction belongs to, locked by the caller
+    /// @param[in] instruction Instruction to insert, ownership is moved.
+    /// @param[in] hash structural hash of instruction
+    /// @return Pointer to the Instruction now owned by the Module
+    const Instruction* InsertInstruction(InstructionShard& shard, Instruction&& instruction, std::size_t hash);
+
+    /// InsertInstruction for callers already holding the lock of m_GraphMutex
+    const Instruction* AppendInstruction(InstructionShard& shard, Instruction&& instruction, std::size_t hash);
+
+    /// Record an Instruction as a user of each Instruction its Operands point to
+    /// @param[in] user Instruction owned by the Module
+    void AddUses(const Instruction& user);
+
+    /// Remove an Instruction from the users of each Instruction its Operands point to
+    /// @param[in] user Instruction owned by the Module
+    void RemoveUses(const Instruction& user);
+
+    /// Construction options of the Module, which its forks are created with
+    ModuleOptions m_Options;
+    /// Arena backing the Module's storage when ModuleOptions::m_UseArena is set, shared with its sealed layers
+    std::shared_ptr<ModuleArena> m_Arena;
+    /// Memory resource all Instructions, operand arrays and table nodes are allocated from
+    std::pmr::memory_resource* m_Resource;
+
+    /// Whether the emplacement functions lock the Module, see ModuleOptions::m_Concurrent
+    bool m_Concurrent;
+    /// Next ResId to assign
+    std::atomic<uint32_t> m_ResId{1};
+    /// Next graph constant id to allocate
+    std::atomic<uint32_t> m_GraphConstantId{0};
+    /// Guards the Instructions, the opcode groups and the use index of the own layer in concurrent Modules
+    mutable std::mutex m_GraphMutex;
+    /// Guards the strings of the own layer in concurrent Modules
+    std::mutex m_StringMutex;
+    /// Layers of the Module, oldest first, see Layer
+    std::vector<std::shared_ptr<Layer>> m_Layers;
+    /// Own layer of the Module, the last of m_Layers
+    Layer* m_OwnLayer;
+    /// Graphs recorded by AddGraphDefinition
+    std::vector<GraphDefinition> m_Graphs;
+
+    /// Direct-mapped type cache, see FindCachedType
+    std::vector<TypeCacheSlot> m_TypeCache;
+    TypeCacheStats m_TypeCacheStats;
+    /// Guards m_TypeCache and m_TypeCacheStats in concurrent Modules
+    mutable std::mutex m_TypeCacheMutex;
+
+    /// Constants with a small tag and value, indexed by tag then value, see FindPooledConstant
+    std::vector<std::array<const Instruction*, SmallConstantCount>> m_SmallConstants;
+    /// Open-addressing table of the other pooled constants, linearly probed, its size is a power of two
+    std::vector<ConstantPoolSlot> m_ConstantPool;
+    /// Number of occupied slots of m_ConstantPool
+    std::size_t m_ConstantPoolSize = 0;
+    /// Guards m_SmallConstants and m_ConstantPool in concurrent Modules
+    mutable std::mutex m_ConstantPoolMutex;
+
+    /// Whether Layer::m_Users is maintained
+    bool m_TrackUses;
 };
 
 /// Operand Instance used to specify the position of an Instructions ResId
 static const auto RESID = Operand{0u, RES_ID};
 
-} // namespace tfsc::spirv
\ No newline at end of file
+} // namespace tfsc::spirv
@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <vector>
 
 // tosa-for-spirv-codegen's shorthand namespace
 namespace tfsc::spirv
@@ -21,76 +25,116 @@ enum OperandType
     UNINITIALIZED,
 };
 
+/// Immutable payload of a LITERAL_STRING Operand.
+/// LiteralStrings are owned by the Module they were emplaced into (see Module::EmplaceString),
+/// Operands only refer to them. The hash and the null-terminated, zero-padded SPIR-V encoding are computed once
+/// on construction, and both the string and its encoding are allocated from the memory resource of the Module.
+class alignas(8) LiteralString
+{
+    public:
+    /// Constructor for LiteralString
+    /// @param[in] str string value
+    /// @param[in] resource memory resource the string and its encoding are allocated from
+    explicit LiteralString(std::string_view str,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /// Getter for the string value.
+    /// @return const std::pmr::string&
+    const std::pmr::string& GetString() const { return m_String; }
+
+    /// Getter for the SPIR-V encoding of the string, including the terminating null character and padding.
+    /// @return const std::pmr::vector<uint32_t>& words
+    const std::pmr::vector<uint32_t>& GetWords() const { return m_Words; }
+
+    /// Getter for the hash of the string value.
+    /// @return std::size_t hash value
+    std::size_t GetHash() const { return m_Hash; }
+
+    private:
+    std::pmr::string m_String;
+    std::pmr::vector<uint32_t> m_Words;
+    std::size_t m_Hash;
+};
+
 class Instruction;
 /// tosa-for-spirv-codegen's implementation of SPIR-V operand.
 /// Operand is a typed union that can be either an uint32_t word, string or pointer to an Instruction
 /// Operands are the default return value for most tosa-for-spirv-codegen functions
+/// The type is encoded in the low bits of a single 64-bit word: pointers to Instructions and LiteralStrings are at
+/// least 8-byte aligned, while words are stored in the upper 32 bits. Operands are therefore 8 bytes and trivially
+/// copyable, and do not own the Instruction or LiteralString they point to.
 class Operand
 {
     public:
-    /// Default constructor for Operand with m_Type = UNINITIALIZED and m_LiteralWord = 0.
-    Operand()
-        : m_Type(UNINITIALIZED)
-        , m_LiteralWord(0)
+    /// Default constructor for Operand with type UNINITIALIZED and literal word 0.
+    constexpr Operand()
+        : m_Bits(UNINITIALIZED)
     {
     }
 
     /// LITERAL_WORD Constructor for Operand
     /// @param[in] word uint32_t value
     /// @param[in] type type either LITERAL_WORD or RES_ID defaulting to LITERAL_WORD
-    explicit Operand(const uint32_t word, const OperandType type = LITERAL_WORD)
-        : m_Type(type)
-        , m_LiteralWord{word}
+    constexpr explicit Operand(const uint32_t word, const OperandType type = LITERAL_WORD)
+        : m_Bits((static_cast<uint64_t>(word) << 32) | (static_cast<uint64_t>(type) & TypeMask))
     {
     }
 
     /// INSTRUCTION_POINTER Constructor for Operand
     /// @param[in] instruction_ptr const Instruction* pointer
     explicit Operand(const Instruction* instruction_ptr)
-        : m_Type(INSTRUCTION_POINTER)
-        , m_InstructionPtr(instruction_ptr)
-    {
-    }
-
-    /// LITERAL_STRING Constructor for Operand
-    /// @param[in] str const std::string&
-    explicit Operand(const std::string& str)
-        : m_Type(LITERAL_STRING)
-        , m_LiteralStr(new auto(str))
+        : m_Bits(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(instruction_ptr)) | INSTRUCTION_POINTER)
     {
     }
 
     /// LITERAL_STRING Constructor for Operand
-    /// @param[in] str const char*  const std::string&
-    explicit Operand(const char* str)
-        : m_Type(LITERAL_STRING)
-        , m_LiteralStr(new std::basic_string<char>(str))
+    /// @param[in] str string payload, which must outlive the Operand
+    explicit Operand(const LiteralString* str)
+        : m_Bits(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(str)) | LITERAL_STRING)
     {
     }
 
-    // Special member functions for typed enums have to be handwritten
-    Operand& operator=(const Operand& other);
-    /// Copy Constructor
-    Operand(const Operand& rhs) noexcept;
-    /// Move Constructor
-    Operand(Operand&& rhs) noexcept;
-    /// Move Assignment Operator
-    Operand& operator=(Operand&& rhs) noexcept;
-
     bool operator<(const Operand& other) const;
     bool operator==(const Operand& other) const;
     bool operator!=(const Operand& operand) const { return !(*this == operand); }
 
     uint32_t WordSize() const;
-    ~Operand();
 
-    OperandType m_Type;
-    union
+    /// Hash of the Operand's value, consistent with operator==
+    /// RES_ID Operands hash by type only, as their value is assigned by the Module after deduplication.
+    /// @return std::size_t hash value
+    std::size_t Hash() const;
+
+    /// Getter for the type of the Operand.
+    /// @return OperandType
+    OperandType GetType() const { return static_cast<OperandType>(m_Bits & TypeMask); }
+
+    /// Getter for the value of a LITERAL_WORD or RES_ID Operand.
+    /// @return uint32_t word
+    uint32_t GetLiteralWord() const { return static_cast<uint32_t>(m_Bits >> 32); }
+
+    /// Getter for the Instruction pointed to by an INSTRUCTION_POINTER Operand.
+    /// @return const Instruction* pointer
+    const Instruction* GetInstructionPtr() const
     {
-        uint32_t m_LiteralWord{};
-        std::basic_string<char>* m_LiteralStr;
-        const Instruction* m_InstructionPtr;
-    };
+        return reinterpret_cast<const Instruction*>(static_cast<uintptr_t>(m_Bits & ~TypeMask));
+    }
+
+    /// Getter for the payload of a LITERAL_STRING Operand.
+    /// @return const LiteralString& payload
+    const LiteralString& GetLiteralString() const
+    {
+        return *reinterpret_cast<const LiteralString*>(static_cast<uintptr_t>(m_Bits & ~TypeMask));
+    }
+
+    /// Getter for the string of a LITERAL_STRING Operand.
+    /// @return const std::pmr::string&
+    const std::pmr::string& GetLiteralStr() const { return GetLiteralString().GetString(); }
+
+    private:
+    static constexpr uint64_t TypeMask = 0x7;
+
+    uint64_t m_Bits;
 };
 
-} // namespace tfsc::spirv
\ No newline at end of file
+} // namespace tfsc::spirv
@@ -8,10 +8,16 @@
 #include "OperatorEnum.hpp"
 #include "Tensor.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
 // tosa-for-spirv-codegen's shorthand namespace
+namespace tfsc
+{
+struct LinkResult;
+}
+
 namespace tfsc::spirv
 {
 class Module;
@@ -20,7 +26,20 @@ class Module;
 namespace tfsc::tosa
 {
 
+/// Expected size of a Graph, used to pre-size the Module the Graph is built in
+struct GraphCapacity
+{
+    /// Number of operators, including the operators producing constants
+    std::size_t m_OperatorCount = 0;
+    /// Number of tensors, including inputs, outputs and constants
+    std::size_t m_TensorCount = 0;
+    /// Number of constants
+    std::size_t m_ConstantCount = 0;
+};
+
 /// Class which encapsulates the concept of a graph containing layers.
+/// Operators and constants may be added from several threads when the Module is concurrent, see
+/// spirv::ModuleOptions::m_Concurrent. Inputs and outputs must be added, and the graph finalized, by a single thread.
 class Graph
 {
     public:
@@ -29,6 +48,12 @@ class Graph
     /// @param name Optional name for the graph. Defaults to an empty string.
     explicit Graph(std::shared_ptr<spirv::Module> module, std::string name = std::string());
 
+    /// Graph constructor, pre-sizing the Module for a Graph of a known size
+    /// @param module Shared pointer to the SPIR-V module the graph will be added to.
+    /// @param name Name for the graph.
+    /// @param capacity Expected size of the graph, see Module::Reserve
+    Graph(std::shared_ptr<spirv::Module> module, std::string name, const GraphCapacity& capacity);
+
     /// Add an input to the graph, specifying the binding id (Descriptor Set will be 0)
     /// @param[in] input Tensor describing the input
     /// @param[in] bindingId binding id
@@ -57,6 +82,13 @@ class Graph
     /// @return A ResId of the GraphConstant
     ResId AddTensorConstant(const Attribute& attribute);
 
+    /// Import the Instructions of another Module into the Module of this graph, see tfsc::LinkModules
+    /// Typically the source holds operators and constants built on another thread, by a graph that is not finalized.
+    /// Graph constants added to this graph afterwards are numbered after the imported ones.
+    /// @param[in] source Module to import
+    /// @return Mapping from the ResIds of the source to ResIds of this graph
+    LinkResult Link(const std::shared_ptr<spirv::Module>& source);
+
     /// General function to add an operator,
     /// All subsequent AddOperator functions are specialized wrappers of this function.
     /// @param[in] operatorType The operator type enum.
@@ -73,10 +105,22 @@ class Graph
     /// @return name of Graph
     const std::string& GetName() const { return m_Name; }
 
+    /// Get the Module the graph is added to
+    /// @return Shared pointer to the SPIR-V module of the Graph
+    const std::shared_ptr<spirv::Module>& GetModule() const { return m_Module; }
+
     /// Once all Operators and IO are set, this function creates the spirv instructions describing the graph
+    /// Several graphs can be finalized into the same Module, each with its own entry point, sharing the Module's
+    /// types and constants; see spirv::GraphDefinition.
     /// After being called no more changes may be made to this graph.
     void FinalizeGraph();
 
+    /// Fork the graph in constant time, e.g. to complete several variants of a shared prefix, see Module::Fork
+    /// The fork refers to the same inputs, outputs and operators, in a fork of the Module of this graph. Both graphs
+    /// can then be completed and finalized independently.
+    /// @return The forked graph
+    Graph Fork() const;
+
     // See tosa_for_spirv_codegen/python/source_generator.py and README
     // THIS SECTION IS GENERATED WITH TOSA 1.0. DO NOT EDIT!
     // GRAPH OPERATOR HELPER FUNCTION BEGIN
@@ -840,8 +884,9 @@ class Graph
     // Instructions built up over the lifetime of the graph, then inserted at lifetime end
     std::vector<const spirv::Instruction*> m_Inputs;
     std::vector<const spirv::Instruction*> m_Outputs;
-
-    uint32_t m_GraphConstantId = 0;
+    // OpGraphInputARM and OpGraphSetOutputARM Instructions, recorded in the Module's GraphDefinition
+    std::vector<const spirv::Instruction*> m_GraphInputs;
+    std::vector<const spirv::Instruction*> m_GraphOutputs;
 };
 
 } // namespace tfsc::tosa
@@ -192,7 +192,7 @@ class Attribute
         : m_ResId(resId) {};
 
     const std::vector<uint32_t>& GetData() const { return m_AttributeData; }
-    Tensor GetTensor() const { return m_Tensor; }
+    const Tensor& GetTensor() const { return m_Tensor; }
     ResId GetResId() const { return m_ResId; }
 
     bool operator==(const Attribute& other) const
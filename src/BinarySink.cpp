@@ -0,0 +1,95 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <BinarySink.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace tfsc
+{
+
+BufferSink::BufferSink(uint32_t* buffer, const std::size_t capacity)
+    : m_Buffer(buffer)
+    , m_Capacity(capacity)
+{
+}
+
+void BufferSink::Write(const uint32_t* words, const std::size_t wordCount)
+{
+    if (wordCount > m_Capacity - m_WordCount)
+    {
+        throw std::runtime_error("BufferSink: binary of more than " + std::to_string(m_Capacity) +
+                                 " words does not fit in the buffer");
+    }
+    std::copy(words, words + wordCount, m_Buffer + m_WordCount);
+    m_WordCount += wordCount;
+}
+
+StreamSink::StreamSink(std::ostream& stream)
+    : m_Stream(stream)
+{
+}
+
+void StreamSink::Write(const uint32_t* words, const std::size_t wordCount)
+{
+    m_Stream.write(reinterpret_cast<const char*>(words), static_cast<std::streamsize>(wordCount * sizeof(uint32_t)));
+    if (!m_Stream)
+    {
+        throw std::runtime_error("StreamSink: failed to write to the output stream");
+    }
+}
+
+FileDescriptorSink::FileDescriptorSink(const int fileDescriptor)
+    : m_FileDescriptor(fileDescriptor)
+{
+}
+
+void FileDescriptorSink::Write(const uint32_t* words, const std::size_t wordCount)
+{
+    const char* data = reinterpret_cast<const char*>(words);
+    std::size_t remaining = wordCount * sizeof(uint32_t);
+    while (remaining > 0)
+    {
+#ifdef _WIN32
+        const auto chunk = static_cast<unsigned int>(std::min<std::size_t>(remaining, 1u << 30));
+        const auto written = _write(m_FileDescriptor, data, chunk);
+#else
+        const auto written = write(m_FileDescriptor, data, remaining);
+#endif
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            throw std::runtime_error("FileDescriptorSink: failed to write to file descriptor " +
+                                     std::to_string(m_FileDescriptor));
+        }
+        data += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+}
+
+CallbackSink::CallbackSink(Callback callback)
+    : m_Callback(std::move(callback))
+{
+}
+
+void CallbackSink::Write(const uint32_t* words, const std::size_t wordCount)
+{
+    m_Callback(words, wordCount);
+}
+
+} // namespace tfsc
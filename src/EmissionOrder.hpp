@@ -0,0 +1,28 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#pragma once
+
+#include <Module.hpp>
+
+#include <vector>
+
+namespace tfsc
+{
+
+/// Instructions of a Module in the order they are written to the binary
+using EmissionOrder = std::vector<const spirv::Instruction*>;
+
+/// Order the Instructions of a Module as they are written to the binary
+/// Instructions the graph does not reach are left out of the order.
+/// Throws std::runtime_error if the graphs are split and an operator is part of several graphs.
+/// @param[in] module the spirv Module
+/// @param[in] reportUnwritten print the Instructions left out of the order to std::cout
+/// @param[in] splitGraphs write the body of each graph of a multi-graph Module between its own OpGraphARM and
+/// OpGraphEndARM, otherwise order the bodies together as in a single graph Module, which leaves out the same
+/// Instructions and never throws
+/// @return pointers to the Instructions of the Module, in emission order
+EmissionOrder GetEmissionOrder(const spirv::Module& module, bool reportUnwritten = true, bool splitGraphs = true);
+
+} // namespace tfsc
@@ -0,0 +1,96 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <EmissionOrder.hpp>
+#include <FrozenModule.hpp>
+#include <Module.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace tfsc::spirv
+{
+
+FrozenModule Module::Freeze() const
+{
+    const auto order = GetEmissionOrder(*this);
+
+    // Position of each written Instruction in the emission order, indexed by result id
+    constexpr uint32_t NotWritten = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> indices(m_ResId.load(), NotWritten);
+    std::size_t operandCount = 0;
+    for (std::size_t idx = 0; idx < order.size(); ++idx)
+    {
+        if (order[idx]->HasResId())
+        {
+            indices[order[idx]->GetResId()] = static_cast<uint32_t>(idx);
+        }
+        operandCount += order[idx]->m_Operands.size();
+    }
+
+    FrozenModule frozen;
+    frozen.m_Opcodes.reserve(order.size());
+    frozen.m_WordCounts.reserve(order.size());
+    frozen.m_ResIds.reserve(order.size());
+    frozen.m_OperandOffsets.reserve(order.size() + 1);
+    frozen.m_OperandTypes.reserve(operandCount);
+    frozen.m_OperandValues.reserve(operandCount);
+
+    std::unordered_map<const LiteralString*, uint32_t> stringIndices;
+    for (std::size_t idx = 0; idx < order.size(); ++idx)
+    {
+        const Instruction& instruction = *order[idx];
+        frozen.m_Opcodes.push_back(instruction.m_Opcode);
+        frozen.m_WordCounts.push_back(instruction.m_WordCount);
+        frozen.m_ResIds.push_back(instruction.GetResId());
+
+        for (const Operand& operand : instruction.m_Operands)
+        {
+            uint32_t value = 0;
+            switch (operand.GetType())
+            {
+                case LITERAL_WORD: value = operand.GetLiteralWord(); break;
+                case RES_ID: value = static_cast<uint32_t>(idx); break;
+                case INSTRUCTION_POINTER:
+                {
+                    const Instruction* target = operand.GetInstructionPtr();
+                    value = target->HasResId() ? indices[target->GetResId()] : NotWritten;
+                    if (value == NotWritten)
+                    {
+                        throw std::runtime_error("Module::Freeze: a written Instruction refers to an Instruction "
+                                                 "that is not written");
+                    }
+                    break;
+                }
+                case LITERAL_STRING:
+                {
+                    const LiteralString& string = operand.GetLiteralString();
+                    const auto [it, inserted] =
+                        stringIndices.emplace(&string, static_cast<uint32_t>(stringIndices.size()));
+                    if (inserted)
+                    {
+                        const auto& words = string.GetWords();
+                        frozen.m_StringWords.insert(frozen.m_StringWords.end(), words.begin(), words.end());
+                        frozen.m_StringOffsets.push_back(static_cast<uint32_t>(frozen.m_StringWords.size()));
+                    }
+                    value = it->second;
+                    break;
+                }
+                default: break;
+            }
+            frozen.m_OperandTypes.push_back(operand.GetType());
+            frozen.m_OperandValues.push_back(value);
+        }
+        frozen.m_OperandOffsets.push_back(static_cast<uint32_t>(frozen.m_OperandValues.size()));
+    }
+
+    // The same bound as WriteToBinary
+    frozen.m_ResIdBound = std::max(static_cast<uint32_t>(GetSpirvGraph().size()), m_ResId.load());
+    return frozen;
+}
+
+} // namespace tfsc::spirv
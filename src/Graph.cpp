@@ -6,6 +6,7 @@
 #include <Graph.hpp>
 #include <OperatorDefinitions.hpp>
 #include <SPIRVDefinitions.hpp>
+#include <TosaForSpirvCodegen.hpp>
 
 #include <algorithm>
 
@@ -22,6 +23,21 @@ Graph::Graph(std::shared_ptr<Module> module, std::string name)
 {
 }
 
+Graph::Graph(std::shared_ptr<Module> module, std::string name, const GraphCapacity& capacity)
+    : Graph(std::move(module), std::move(name))
+{
+    // Rough upper bounds of the Instructions added per element of the graph: an OpExtInst and its attribute
+    // constants per operator, the type and shape Instructions per tensor and a constant with its type per constant
+    constexpr std::size_t instructionsPerOperator = 8;
+    constexpr std::size_t instructionsPerTensor = 6;
+    constexpr std::size_t instructionsPerConstant = 4;
+    constexpr std::size_t operandsPerInstruction = 4;
+    const auto instructionCount = capacity.m_OperatorCount * instructionsPerOperator +
+                                  capacity.m_TensorCount * instructionsPerTensor +
+                                  capacity.m_ConstantCount * instructionsPerConstant;
+    m_Module->Reserve(instructionCount, instructionCount * operandsPerInstruction);
+}
+
 ResId Graph::AddInput(const Tensor& input, const unsigned int bindingId)
 {
     const auto inputId = CreateConstant(m_Inputs.size(), DataType::uint32_t, *m_Module);
@@ -37,8 +53,11 @@ ResId Graph::AddInput(const Tensor& input, const unsigned int bindingId)
     m_Module->EmplaceInstruction(OpDecorate, {opVariable, Operand{DecorationDescriptorSet}, Operand{0u}});
     m_Module->EmplaceInstruction(OpDecorate, {opVariable, Operand{DecorationBinding}, Operand{bindingId}});
 
-    m_Inputs.emplace_back(opVariable.m_InstructionPtr);
-    return m_Module->EmplaceInstruction(OpGraphInputARM, {tensor, RESID, inputId}).m_InstructionPtr;
+    m_Inputs.emplace_back(opVariable.GetInstructionPtr());
+    // Inputs of different graphs with the same index and type are distinct
+    const auto graphInput = m_Module->EmplaceInstructionNonUnique(OpGraphInputARM, {tensor, RESID, inputId});
+    m_GraphInputs.push_back(graphInput.GetInstructionPtr());
+    return graphInput.GetInstructionPtr();
 }
 
 void Graph::AddOutput(const ResId outputTensor, const unsigned int bindingId)
@@ -47,7 +66,9 @@ void Graph::AddOutput(const ResId outputTensor, const unsigned int bindingId)
     const auto tensor = outputTensor->m_Operands[0];
     const auto outputIdOperand = CreateConstant(m_Outputs.size(), DataType::int32_t, *m_Module);
 
-    m_Module->EmplaceInstruction(OpGraphSetOutputARM, {Operand{outputTensor}, outputIdOperand});
+    const auto graphOutput =
+        m_Module->EmplaceInstruction(OpGraphSetOutputARM, {Operand{outputTensor}, outputIdOperand});
+    m_GraphOutputs.push_back(graphOutput.GetInstructionPtr());
     auto uniformConstantPtr =
         m_Module->EmplaceInstruction(OpTypePointer, {RESID, Operand{StorageClassUniformConstant}, tensor});
 
@@ -58,26 +79,38 @@ void Graph::AddOutput(const ResId outputTensor, const unsigned int bindingId)
     m_Module->EmplaceInstruction(OpDecorate, {opVariable, Operand{DecorationDescriptorSet}, Operand{0u}});
     m_Module->EmplaceInstruction(OpDecorate, {opVariable, Operand{DecorationBinding}, Operand{bindingId}});
 
-    m_Outputs.emplace_back(opVariable.m_InstructionPtr);
+    m_Outputs.emplace_back(opVariable.GetInstructionPtr());
 }
 
 ResId Graph::AddGraphConstant(const Tensor& tensor)
 {
     const auto tensorOperand = CreateTensor(tensor, *m_Module);
-    return m_Module->EmplaceInstruction(OpGraphConstantARM, {tensorOperand, RESID, Operand{m_GraphConstantId++}})
-        .m_InstructionPtr;
+    const Operand constantId{m_Module->AllocateGraphConstantId()};
+    return m_Module->EmplaceInstruction(OpGraphConstantARM, {tensorOperand, RESID, constantId}).GetInstructionPtr();
 }
 
 ResId Graph::AddExternalGraphConstant(const Tensor& tensor)
 {
     const auto tensorOperand = CreateTensor(tensor, *m_Module);
-    return m_Module->EmplaceInstruction(OpGraphConstantARM, {tensorOperand, RESID, Operand{m_GraphConstantId++}})
-        .m_InstructionPtr;
+    const Operand constantId{m_Module->AllocateGraphConstantId()};
+    return m_Module->EmplaceInstruction(OpGraphConstantARM, {tensorOperand, RESID, constantId}).GetInstructionPtr();
 }
 
 ResId Graph::AddTensorConstant(const Attribute& attribute)
 {
-    return CreateAttribute(attribute, *m_Module).m_InstructionPtr;
+    return CreateAttribute(attribute, *m_Module).GetInstructionPtr();
+}
+
+LinkResult Graph::Link(const std::shared_ptr<Module>& source)
+{
+    return LinkModules(m_Module, source);
+}
+
+Graph Graph::Fork() const
+{
+    Graph fork = *this;
+    fork.m_Module = m_Module->Fork();
+    return fork;
 }
 
 // Forward declaration of the static helper function ChainConcat.
@@ -172,7 +205,7 @@ std::vector<ResId> Graph::AddOperator(const OperatorEnum operatorType,
     }
     else
     {
-        operatorResId = m_Module->EmplaceInstruction(OpExtInst, {operands});
+        operatorResId = m_Module->EmplaceInstruction(OpExtInst, operands);
     }
 
     if (outputs.size() == 2)
@@ -184,10 +217,10 @@ std::vector<ResId> Graph::AddOperator(const OperatorEnum operatorType,
             m_Module->EmplaceInstruction(OpCompositeExtract,
                                          {outputTensorTypeOpVec[2], RESID, operatorResId, Operand{1u}});
 
-        return {output0CompositeExtractInst0.m_InstructionPtr, output0CompositeExtractInst1.m_InstructionPtr};
+        return {output0CompositeExtractInst0.GetInstructionPtr(), output0CompositeExtractInst1.GetInstructionPtr()};
     }
 
-    return {operatorResId.m_InstructionPtr};
+    return {operatorResId.GetInstructionPtr()};
 }
 
 void Graph::FinalizeGraph()
@@ -203,26 +236,29 @@ void Graph::FinalizeGraph()
     for (const auto& input : m_Inputs)
     {
         *entryPointOperandsIOBegin++ = Operand{input};
-        const auto tensor = input->m_Operands[0].m_InstructionPtr->m_Operands[2];
+        const auto tensor = input->m_Operands[0].GetInstructionPtr()->m_Operands[2];
         *graphTypeOperandsIOBegin++ = tensor;
     }
     for (const auto& output : m_Outputs)
     {
         *entryPointOperandsIOBegin++ = Operand{output};
-        const auto tensor = output->m_Operands[0].m_InstructionPtr->m_Operands[2];
+        const auto tensor = output->m_Operands[0].GetInstructionPtr()->m_Operands[2];
         *graphTypeOperandsIOBegin++ = tensor;
     }
 
     graphTypeOperands[0] = RESID;
     graphTypeOperands[1] = Operand{static_cast<uint32_t>(m_Inputs.size())};
     auto graphTypeInstruction = m_Module->EmplaceInstruction(OpTypeGraphARM, graphTypeOperands);
-    const auto graphArm = m_Module->EmplaceInstruction(OpGraphARM, {graphTypeInstruction, RESID});
+    // Graphs of the same type are distinct, as are the ends of the graphs
+    const auto graphArm = m_Module->EmplaceInstructionNonUnique(OpGraphARM, {graphTypeInstruction, RESID});
 
     entryPointOperands[0] = graphArm;
-    entryPointOperands[1] = Operand{m_Name};
+    entryPointOperands[1] = m_Module->EmplaceString(m_Name);
 
     m_Module->EmplaceInstruction(OpGraphEntryPointARM, entryPointOperands);
-    m_Module->EmplaceInstruction(OpGraphEndARM, {});
+    const auto graphEnd = m_Module->EmplaceInstructionNonUnique(OpGraphEndARM, {});
+    m_Module->AddGraphDefinition(
+        {graphArm.GetInstructionPtr(), m_GraphInputs, m_GraphOutputs, graphEnd.GetInstructionPtr()});
     // Graph is complete no more instructions should be added.
     m_Module.reset();
 }
@@ -33,7 +33,7 @@ bool InstructionComparator::operator()(const Instruction& lhs, const Instruction
     auto itRhs = rhs.m_Operands.crbegin();
     for (auto itLhs = lhs.m_Operands.crbegin(); itLhs != lhs.m_Operands.crend(); ++itLhs, ++itRhs)
     {
-        if (itLhs->m_Type == RES_ID)
+        if (itLhs->GetType() == RES_ID)
         {
             continue;
         }
@@ -45,4 +45,66 @@ bool InstructionComparator::operator()(const Instruction& lhs, const Instruction
     return false;
 }
 
+std::size_t Instruction::ComputeHash(const spv::Op opCode,
+                                     const Operand* operands,
+                                     const std::size_t operandCount) noexcept
+{
+    return InstructionHash{}(opCode, operands, operandCount);
+}
+
+std::size_t InstructionHash::operator()(const Instruction& instruction) const noexcept
+{
+    return instruction.GetHash();
+}
+
+std::size_t InstructionHash::operator()(const spv::Op opCode,
+                                        const Operand* operands,
+                                        const std::size_t operandCount) const noexcept
+{
+    std::size_t hash = static_cast<std::size_t>(opCode);
+    for (std::size_t idx = 0; idx < operandCount; ++idx)
+    {
+        hash ^= operands[idx].Hash() + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+bool InstructionEqual::operator()(const Instruction& lhs, const Instruction& rhs) const noexcept
+{
+    if (lhs.GetHash() != rhs.GetHash())
+    {
+        return false;
+    }
+    return (*this)(lhs, rhs.m_Opcode, rhs.m_Operands.data(), rhs.m_Operands.size());
+}
+
+bool InstructionEqual::operator()(const Instruction& lhs,
+                                  const spv::Op opCode,
+                                  const Operand* operands,
+                                  const std::size_t operandCount) const noexcept
+{
+    if (lhs.m_Opcode != opCode || lhs.m_Operands.size() != operandCount)
+    {
+        return false;
+    }
+    for (std::size_t idx = 0; idx < operandCount; ++idx)
+    {
+        const Operand& lhsOperand = lhs.m_Operands[idx];
+        const Operand& rhsOperand = operands[idx];
+        if (lhsOperand.GetType() != rhsOperand.GetType())
+        {
+            return false;
+        }
+        if (lhsOperand.GetType() == RES_ID || lhsOperand.GetType() == UNINITIALIZED)
+        {
+            continue;
+        }
+        if (lhsOperand != rhsOperand)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace tfsc::spirv
@@ -5,42 +5,716 @@
 
 #include <Module.hpp>
 
-#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 
 namespace tfsc::spirv
 {
 
-Operand Module::EmplaceInstruction(const spv::Op opCode, std::vector<Operand> operands)
+/// Bump allocator backing arena Modules, memory is only released when the arena is destroyed
+/// Chunks grow geometrically, and Reserve sets aside a chunk for a known amount of upcoming allocations.
+/// A synchronized arena can be allocated from by several threads at once.
+class ModuleArena : public std::pmr::memory_resource
 {
-    Instruction inst{opCode, std::move(operands)};
-    const auto res = m_SPIRVGraph.find(inst);
-    if (res == m_SPIRVGraph.end())
+    public:
+    ModuleArena(const std::size_t chunkSize, const bool synchronized)
+        : m_NextChunkSize(std::max<std::size_t>(chunkSize, 1))
+        , m_Synchronized(synchronized)
     {
-        for (auto& operand : inst.m_Operands)
+    }
+
+    /// Ensure the next bytes of allocations are served from the current chunk, starting a new chunk if needed
+    /// @param[in] bytes number of bytes to set aside
+    void Reserve(const std::size_t bytes)
+    {
+        const auto lock = Lock();
+        if (bytes > m_Remaining)
+        {
+            AllocateChunk(bytes);
+        }
+    }
+
+    private:
+    void* do_allocate(std::size_t bytes, const std::size_t alignment) override
+    {
+        bytes = std::max<std::size_t>(bytes, 1);
+        const auto lock = Lock();
+        void* ptr = m_Current;
+        if (!std::align(alignment, bytes, ptr, m_Remaining))
+        {
+            AllocateChunk(std::max(m_NextChunkSize, bytes + alignment));
+            m_NextChunkSize *= 2;
+            ptr = m_Current;
+            std::align(alignment, bytes, ptr, m_Remaining);
+        }
+        m_Current = static_cast<char*>(ptr) + bytes;
+        m_Remaining -= bytes;
+        return ptr;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::unique_lock<std::mutex> Lock()
+    {
+        return m_Synchronized ? std::unique_lock<std::mutex>(m_Mutex) : std::unique_lock<std::mutex>();
+    }
+
+    void AllocateChunk(const std::size_t bytes)
+    {
+        // Chunks are left uninitialised, so reserved memory is only touched once it is used
+        m_Chunks.emplace_back(new char[bytes]);
+        m_Current = m_Chunks.back().get();
+        m_Remaining = bytes;
+    }
+
+    std::vector<std::unique_ptr<char[]>> m_Chunks;
+    char* m_Current = nullptr;
+    std::size_t m_Remaining = 0;
+    std::size_t m_NextChunkSize;
+    bool m_Synchronized;
+    std::mutex m_Mutex;
+};
+
+/// Estimated arena bytes taken by each Instruction besides its operands: its list node, its node and bucket in
+/// the deduplication table and its slot in the use index
+constexpr std::size_t ArenaBytesPerInstruction = sizeof(Instruction) + 8 * sizeof(void*);
+/// Estimated arena bytes taken by each string: its list node, the encoding of a short string and its node and bucket
+/// in the interning table
+constexpr std::size_t ArenaBytesPerString = sizeof(LiteralString) + 4 * sizeof(uint32_t) + 8 * sizeof(void*);
+
+Module::Layer::Layer(std::shared_ptr<ModuleArena> arena,
+                     std::pmr::memory_resource* resource,
+                     const std::size_t shardCount)
+    : m_Arena(std::move(arena))
+    , m_SPIRVGraph(resource)
+    , m_Strings(resource)
+    , m_StringTable(resource)
+    , m_Users(resource)
+{
+    m_Shards.reserve(shardCount);
+    for (std::size_t idx = 0; idx < shardCount; ++idx)
+    {
+        m_Shards.push_back(std::make_unique<InstructionShard>(resource));
+    }
+}
+
+std::pair<Module::InstructionList::const_iterator, Module::InstructionList::const_iterator>
+Module::Layer::GetRange(const spv::Op opCode, const bool allOpcodes) const
+{
+    if (allOpcodes)
+    {
+        return {m_SPIRVGraph.begin(), m_SPIRVGraph.end()};
+    }
+    const auto group = m_OpcodeGroups.find(opCode);
+    if (group == m_OpcodeGroups.end())
+    {
+        return {m_SPIRVGraph.end(), m_SPIRVGraph.end()};
+    }
+    return {group->second.m_First, std::next(group->second.m_Last)};
+}
+
+void Module::InstructionIterator::SeekLayer(std::size_t layer)
+{
+    for (; layer < m_LayerCount; ++layer)
+    {
+        const auto [begin, end] = layer + 1 == m_LayerCount
+                                      ? std::make_pair(m_OwnBegin, m_OwnEnd)
+                                      : m_Module->m_Layers[layer]->GetRange(m_Opcode, m_AllOpcodes);
+        if (begin != end)
+        {
+            m_Layer = layer;
+            m_It = begin;
+            m_End = end;
+            return;
+        }
+    }
+    m_Layer = m_LayerCount;
+    m_It = {};
+    m_End = {};
+}
+
+Module::Module(const ModuleOptions& options)
+    : m_Options(options)
+    , m_Arena(options.m_UseArena ? std::make_shared<ModuleArena>(options.m_ArenaChunkSize, options.m_Concurrent)
+                                 : nullptr)
+    , m_Resource(m_Arena ? m_Arena.get() : std::pmr::get_default_resource())
+    , m_Concurrent(options.m_Concurrent)
+    , m_TrackUses(options.m_TrackUses)
+{
+    std::size_t shardCount = 1;
+    while (m_Concurrent && shardCount < options.m_ShardCount)
+    {
+        shardCount *= 2;
+    }
+    m_Layers.push_back(std::make_shared<Layer>(m_Arena, m_Resource, shardCount));
+    m_OwnLayer = m_Layers.back().get();
+
+    if (options.m_TypeCacheSize > 0)
+    {
+        std::size_t slotCount = 1;
+        while (slotCount < options.m_TypeCacheSize)
+        {
+            slotCount *= 2;
+        }
+        m_TypeCache.resize(slotCount);
+    }
+}
+
+Module::~Module() = default;
+
+void Module::Reserve(const std::size_t instructionCount, const std::size_t operandCount, const std::size_t stringCount)
+{
+    // Set the arena chunk aside first, so the tables below are sized from it
+    if (m_Arena)
+    {
+        m_Arena->Reserve(instructionCount * ArenaBytesPerInstruction + operandCount * sizeof(Operand) +
+                         stringCount * ArenaBytesPerString);
+    }
+    const auto& shards = m_OwnLayer->m_Shards;
+    for (const auto& shard : shards)
+    {
+        shard->m_Table.reserve(shard->m_Table.size() + instructionCount / shards.size() + 1);
+    }
+    m_OwnLayer->m_StringTable.reserve(m_OwnLayer->m_StringTable.size() + stringCount);
+    if (m_TrackUses)
+    {
+        m_OwnLayer->m_Users.reserve(m_ResId.load() + instructionCount);
+    }
+}
+
+Operand Module::EmplaceInstruction(const spv::Op opCode, const Operand* operands, const std::size_t operandCount)
+{
+    const auto hash = InstructionHash{}(opCode, operands, operandCount);
+    if (const auto shared = FindSharedInstruction(opCode, operands, operandCount, hash))
+    {
+        return Operand{shared};
+    }
+    auto& shard = m_OwnLayer->GetShard(hash);
+    // The shard stays locked until the Instruction is inserted, so no other thread can insert a duplicate
+    const auto lock = Lock(shard.m_Mutex);
+    if (const auto res = FindInstruction(shard, opCode, operands, operandCount, hash))
+    {
+        return Operand{res};
+    }
+    return Operand{InsertInstruction(shard, Instruction{opCode, operands, operandCount, hash, m_Resource}, hash)};
+}
+
+Operand Module::EmplaceInstructionNonUnique(const spv::Op opCode, const std::vector<Operand>& operands)
+{
+    Instruction inst{opCode, operands.data(), operands.size(), m_Resource};
+    const auto hash = inst.GetHash();
+    auto& shard = m_OwnLayer->GetShard(hash);
+    const auto lock = Lock(shard.m_Mutex);
+    return Operand{InsertInstruction(shard, std::move(inst), hash)};
+}
+
+void Module::EmplaceInstructions(const InstructionDescriptor* descriptors, const std::size_t count, Operand* results)
+{
+    // Descriptors found in the sealed layers need no lock, the others are left to insert into the own layer
+    std::vector<std::size_t> hashes(count);
+    std::vector<std::size_t> order;
+    order.reserve(count);
+    std::size_t operandCount = 0;
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        const auto& descriptor = descriptors[idx];
+        hashes[idx] = InstructionHash{}(descriptor.m_Opcode, descriptor.m_Operands, descriptor.m_OperandCount);
+        if (const auto shared = FindSharedInstruction(descriptor.m_Opcode,
+                                                      descriptor.m_Operands,
+                                                      descriptor.m_OperandCount,
+                                                      hashes[idx]))
+        {
+            results[idx] = Operand{shared};
+            continue;
+        }
+        order.push_back(idx);
+        operandCount += descriptor.m_OperandCount;
+    }
+    if (m_Arena)
+    {
+        m_Arena->Reserve(order.size() * ArenaBytesPerInstruction + operandCount * sizeof(Operand));
+    }
+
+    // Visit the batch shard by shard, keeping the descriptor order within each shard
+    const auto shardCount = m_OwnLayer->m_Shards.size();
+    const auto shardIndex = [&](const std::size_t idx) { return hashes[idx] & (shardCount - 1); };
+    if (shardCount > 1)
+    {
+        std::stable_sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) {
+            return shardIndex(lhs) < shardIndex(rhs);
+        });
+    }
+
+    for (std::size_t first = 0; first < order.size();)
+    {
+        auto last = first + 1;
+        while (last < order.size() && shardIndex(order[last]) == shardIndex(order[first]))
+        {
+            ++last;
+        }
+
+        auto& shard = m_OwnLayer->GetShard(hashes[order[first]]);
+        const auto shardLock = Lock(shard.m_Mutex);
+        const auto graphLock = Lock(m_GraphMutex);
+        shard.m_Table.reserve(shard.m_Table.size() + (last - first));
+        for (; first < last; ++first)
+        {
+            const auto idx = order[first];
+            const auto& descriptor = descriptors[idx];
+            const auto hash = hashes[idx];
+            if (const auto res = FindInstruction(shard,
+                                                 descriptor.m_Opcode,
+                                                 descriptor.m_Operands,
+                                                 descriptor.m_OperandCount,
+                                                 hash))
+            {
+                results[idx] = Operand{res};
+                continue;
+            }
+            Instruction instruction{descriptor.m_Opcode,
+                                    descriptor.m_Operands,
+                                    descriptor.m_OperandCount,
+                                    hash,
+                                    m_Resource};
+            results[idx] = Operand{AppendInstruction(shard, std::move(instruction), hash)};
+        }
+    }
+}
+
+Operand Module::EmplaceString(const std::string_view str)
+{
+    for (std::size_t layer = 0; layer + 1 < m_Layers.size(); ++layer)
+    {
+        const auto& table = m_Layers[layer]->m_StringTable;
+        if (const auto interned = table.find(str); interned != table.end())
+        {
+            return Operand{interned->second};
+        }
+    }
+
+    const auto lock = Lock(m_StringMutex);
+    auto& table = m_OwnLayer->m_StringTable;
+    const auto interned = table.find(str);
+    if (interned != table.end())
+    {
+        return Operand{interned->second};
+    }
+    const auto& literal = m_OwnLayer->m_Strings.emplace_back(str, m_Resource);
+    table.emplace(literal.GetString(), &literal);
+    return Operand{&literal};
+}
+
+Module::InstructionIterator Module::GetEndIterator() const
+{
+    InstructionIterator end;
+    end.m_Module = this;
+    end.m_Layer = m_Layers.size();
+    end.m_LayerCount = m_Layers.size();
+    return end;
+}
+
+Module::InstructionIterator Module::GetBeginIterator(const spv::Op opCode, const bool allOpcodes) const
+{
+    auto begin = GetEndIterator();
+    begin.m_Opcode = opCode;
+    begin.m_AllOpcodes = allOpcodes;
+    {
+        const auto lock = Lock(m_GraphMutex);
+        std::tie(begin.m_OwnBegin, begin.m_OwnEnd) = m_OwnLayer->GetRange(opCode, allOpcodes);
+    }
+    begin.SeekLayer(0);
+    return begin;
+}
+
+Module::InstructionRange Module::GetInstructionsOfType(const spv::Op opCode) const
+{
+    return {GetBeginIterator(opCode, false), GetEndIterator()};
+}
+
+Module::InstructionView Module::GetSpirvGraph() const
+{
+    InstructionView view;
+    view.m_Begin = GetBeginIterator(spv::OpNop, true);
+    view.m_End = GetEndIterator();
+    for (const auto& layer : m_Layers)
+    {
+        view.m_Size += layer->m_SPIRVGraph.size();
+    }
+    return view;
+}
+
+const Module::UserList* Module::FindUsers(std::size_t layerCount, const uint32_t resId) const
+{
+    while (layerCount-- > 0)
+    {
+        const auto& users = m_Layers[layerCount]->m_Users;
+        if (resId < users.size() && !users[resId].empty())
+        {
+            return &users[resId];
+        }
+    }
+    return nullptr;
+}
+
+const Module::UserList& Module::GetUsers(const Instruction& definition) const
+{
+    if (!m_TrackUses)
+    {
+        throw std::runtime_error("Module::GetUsers: the Module does not track uses, see ModuleOptions::m_TrackUses");
+    }
+    static const UserList noUsers;
+    const auto users = definition.HasResId() ? FindUsers(m_Layers.size(), definition.GetResId()) : nullptr;
+    return users != nullptr ? *users : noUsers;
+}
+
+std::shared_ptr<Module> Module::Fork()
+{
+    // Seal the own layer and start a new one, unless the own layer is empty and so has nothing to share
+    if (!m_OwnLayer->m_SPIRVGraph.empty() || !m_OwnLayer->m_Strings.empty())
+    {
+        m_Layers.push_back(std::make_shared<Layer>(m_Arena, m_Resource, m_OwnLayer->m_Shards.size()));
+        m_OwnLayer = m_Layers.back().get();
+    }
+
+    auto fork = std::make_shared<Module>(m_Options);
+    fork->m_Layers.insert(fork->m_Layers.begin(), m_Layers.begin(), std::prev(m_Layers.end()));
+    fork->m_ResId.store(GetResIdBound(), std::memory_order_relaxed);
+    fork->m_GraphConstantId.store(GetGraphConstantIdBound(), std::memory_order_relaxed);
+    fork->m_Graphs = m_Graphs;
+    return fork;
+}
+
+std::size_t Module::EraseInstructionsIf(const std::function<bool(const Instruction&)>& predicate)
+{
+    // Select every Instruction before removing any, so neither the predicate nor the use index
+    // dereferences an Instruction that has already been removed
+    auto& spirv = m_OwnLayer->m_SPIRVGraph;
+    std::vector<InstructionList::iterator> erased;
+    for (auto it = spirv.begin(); it != spirv.end(); ++it)
+    {
+        if (predicate(*it))
+        {
+            erased.push_back(it);
+        }
+    }
+    EraseInstructions(erased);
+    return erased.size();
+}
+
+std::size_t Module::HashTypeKey(const uint32_t tag, const uint32_t* words, const std::size_t wordCount)
+{
+    std::size_t hash = tag;
+    for (std::size_t idx = 0; idx < wordCount; ++idx)
+    {
+        hash ^= words[idx] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+const Instruction* Module::FindCachedType(const uint32_t tag, const uint32_t* words, const std::size_t wordCount)
+{
+    if (m_TypeCache.empty())
+    {
+        return nullptr;
+    }
+    const auto hash = HashTypeKey(tag, words, wordCount);
+    const auto lock = Lock(m_TypeCacheMutex);
+    const auto& slot = m_TypeCache[hash & (m_TypeCache.size() - 1)];
+    if (slot.m_Type != nullptr && slot.m_Hash == hash && slot.m_Tag == tag && slot.m_WordCount == wordCount &&
+        std::equal(words, words + wordCount, slot.m_Words.begin()))
+    {
+        ++m_TypeCacheStats.m_Hits;
+        return slot.m_Type;
+    }
+    ++m_TypeCacheStats.m_Misses;
+    return nullptr;
+}
+
+void Module::CacheType(const uint32_t tag, const uint32_t* words, const std::size_t wordCount, const Instruction* type)
+{
+    if (m_TypeCache.empty() || wordCount > TypeCacheKeyWords)
+    {
+        return;
+    }
+    const auto hash = HashTypeKey(tag, words, wordCount);
+    const auto lock = Lock(m_TypeCacheMutex);
+    auto& slot = m_TypeCache[hash & (m_TypeCache.size() - 1)];
+    slot.m_Hash = hash;
+    slot.m_Tag = tag;
+    slot.m_WordCount = static_cast<uint32_t>(wordCount);
+    std::copy(words, words + wordCount, slot.m_Words.begin());
+    slot.m_Type = type;
+}
+
+TypeCacheStats Module::GetTypeCacheStats() const
+{
+    const auto lock = Lock(m_TypeCacheMutex);
+    return m_TypeCacheStats;
+}
+
+std::size_t Module::GetConstantPoolSlot(const uint32_t tag, const uint32_t value) const
+{
+    // Multiplicative hashing spreads consecutive values over the table
+    const auto key = (static_cast<uint64_t>(tag) << 32) | value;
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & (m_ConstantPool.size() - 1);
+}
+
+const Instruction* Module::FindPooledConstant(const uint32_t tag, const uint32_t value) const
+{
+    const auto lock = Lock(m_ConstantPoolMutex);
+    if (tag < SmallConstantTagCount && value < SmallConstantCount)
+    {
+        return tag < m_SmallConstants.size() ? m_SmallConstants[tag][value] : nullptr;
+    }
+    if (m_ConstantPool.empty())
+    {
+        return nullptr;
+    }
+    for (auto idx = GetConstantPoolSlot(tag, value);; idx = (idx + 1) & (m_ConstantPool.size() - 1))
+    {
+        const auto& slot = m_ConstantPool[idx];
+        if (slot.m_Constant == nullptr || (slot.m_Tag == tag && slot.m_Value == value))
         {
-            if (operand.m_Type == RES_ID)
+            return slot.m_Constant;
+        }
+    }
+}
+
+void Module::PoolConstant(const uint32_t tag, const uint32_t value, const Instruction* constant)
+{
+    const auto lock = Lock(m_ConstantPoolMutex);
+    if (tag < SmallConstantTagCount && value < SmallConstantCount)
+    {
+        if (tag >= m_SmallConstants.size())
+        {
+            m_SmallConstants.resize(tag + 1, std::array<const Instruction*, SmallConstantCount>{});
+        }
+        m_SmallConstants[tag][value] = constant;
+        return;
+    }
+
+    // Keep the load factor at most a half, so probe sequences stay short
+    if ((m_ConstantPoolSize + 1) * 2 > m_ConstantPool.size())
+    {
+        std::vector<ConstantPoolSlot> slots(std::max<std::size_t>(m_ConstantPool.size() * 2, 64));
+        std::swap(slots, m_ConstantPool);
+        m_ConstantPoolSize = 0;
+        for (const auto& slot : slots)
+        {
+            if (slot.m_Constant != nullptr)
             {
-                operand = Operand{m_ResId++, RES_ID};
-                break;
+                auto idx = GetConstantPoolSlot(slot.m_Tag, slot.m_Value);
+                while (m_ConstantPool[idx].m_Constant != nullptr)
+                {
+                    idx = (idx + 1) & (m_ConstantPool.size() - 1);
+                }
+                m_ConstantPool[idx] = slot;
+                ++m_ConstantPoolSize;
             }
         }
-        return Operand{&(*m_SPIRVGraph.emplace(std::move(inst)))};
     }
-    return Operand{&(*res)};
+
+    auto idx = GetConstantPoolSlot(tag, value);
+    while (m_ConstantPool[idx].m_Constant != nullptr &&
+           (m_ConstantPool[idx].m_Tag != tag || m_ConstantPool[idx].m_Value != value))
+    {
+        idx = (idx + 1) & (m_ConstantPool.size() - 1);
+    }
+    if (m_ConstantPool[idx].m_Constant == nullptr)
+    {
+        ++m_ConstantPoolSize;
+    }
+    m_ConstantPool[idx] = {tag, value, constant};
+}
+
+void Module::ClearCaches()
+{
+    for (auto& slot : m_TypeCache)
+    {
+        slot.m_Type = nullptr;
+    }
+    m_SmallConstants.clear();
+    m_ConstantPool.clear();
+    m_ConstantPoolSize = 0;
 }
 
-Operand Module::EmplaceInstructionNonUnique(const spv::Op opCode, std::vector<Operand> operands)
+void Module::ReserveGraphConstantIds(const uint32_t bound)
 {
-    Instruction inst{opCode, std::move(operands)};
-    for (auto& operand : inst.m_Operands)
+    auto current = m_GraphConstantId.load(std::memory_order_relaxed);
+    while (current < bound && !m_GraphConstantId.compare_exchange_weak(current, bound, std::memory_order_relaxed))
     {
-        if (operand.m_Type == RES_ID)
+    }
+}
+
+void Module::EraseInstructions(const std::vector<InstructionList::iterator>& erased)
+{
+    // The type cache and the constant pool may refer to any of the erased Instructions
+    ClearCaches();
+    if (m_TrackUses)
+    {
+        for (const auto it : erased)
+        {
+            RemoveUses(*it);
+        }
+    }
+
+    auto& layer = *m_OwnLayer;
+    for (const auto it : erased)
+    {
+        if (m_TrackUses && it->HasResId() && it->GetResId() < layer.m_Users.size())
+        {
+            layer.m_Users[it->GetResId()].clear();
+        }
+
+        const auto hash = it->GetHash();
+        auto& table = layer.GetShard(hash).m_Table;
+        const auto [begin, end] = table.equal_range(hash);
+        const auto entry = std::find_if(begin, end, [&](const auto& item) { return item.second == &(*it); });
+        if (entry != end)
+        {
+            table.erase(entry);
+        }
+
+        // Shrink the opcode group, dropping it once its last Instruction is removed
+        const auto group = layer.m_OpcodeGroups.find(it->m_Opcode);
+        if (group->second.m_First == group->second.m_Last)
+        {
+            layer.m_OpcodeGroups.erase(group);
+        }
+        else if (group->second.m_First == it)
+        {
+            group->second.m_First = std::next(it);
+        }
+        else if (group->second.m_Last == it)
+        {
+            group->second.m_Last = std::prev(it);
+        }
+
+        layer.m_SPIRVGraph.erase(it);
+    }
+}
+
+const Instruction* Module::FindInstruction(const InstructionShard& shard,
+                                           const spv::Op opCode,
+                                           const Operand* operands,
+                                           const std::size_t operandCount,
+                                           const std::size_t hash) const
+{
+    const auto [begin, end] = shard.m_Table.equal_range(hash);
+    for (auto it = begin; it != end; ++it)
+    {
+        if (InstructionEqual{}(*it->second, opCode, operands, operandCount))
+        {
+            return it->second;
+        }
+    }
+    return nullptr;
+}
+
+const Instruction* Module::FindSharedInstruction(const spv::Op opCode,
+                                                 const Operand* operands,
+                                                 const std::size_t operandCount,
+                                                 const std::size_t hash) const
+{
+    // Sealed layers are never modified, so they are searched without locking
+    for (std::size_t layer = 0; layer + 1 < m_Layers.size(); ++layer)
+    {
+        if (const auto found = FindInstruction(m_Layers[layer]->GetShard(hash), opCode, operands, operandCount, hash))
+        {
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+const Instruction* Module::InsertInstruction(InstructionShard& shard,
+                                             Instruction&& instruction,
+                                             const std::size_t hash)
+{
+    const auto lock = Lock(m_GraphMutex);
+    return AppendInstruction(shard, std::move(instruction), hash);
+}
+
+const Instruction* Module::AppendInstruction(InstructionShard& shard,
+                                             Instruction&& instruction,
+                                             const std::size_t hash)
+{
+    if (instruction.HasResId())
+    {
+        instruction.SetResId(m_ResId.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    const auto opCode = instruction.m_Opcode;
+    auto& spirv = m_OwnLayer->m_SPIRVGraph;
+    auto& groups = m_OwnLayer->m_OpcodeGroups;
+    InstructionList::iterator inserted;
+    if (const auto group = groups.find(opCode); group != groups.end())
+    {
+        inserted = spirv.insert(std::next(group->second.m_Last), std::move(instruction));
+        group->second.m_Last = inserted;
+    }
+    else
+    {
+        inserted = spirv.insert(spirv.end(), std::move(instruction));
+        groups.emplace(opCode, OpcodeGroup{inserted, inserted});
+    }
+
+    shard.m_Table.emplace(hash, &(*inserted));
+    if (m_TrackUses)
+    {
+        AddUses(*inserted);
+    }
+    return &(*inserted);
+}
+
+void Module::AddUses(const Instruction& user)
+{
+    for (const Operand& operand : user.m_Operands)
+    {
+        if (operand.GetType() != INSTRUCTION_POINTER || !operand.GetInstructionPtr()->HasResId())
+        {
+            continue;
+        }
+        const auto resId = operand.GetInstructionPtr()->GetResId();
+        auto& ownUsers = m_OwnLayer->m_Users;
+        if (resId >= ownUsers.size())
+        {
+            ownUsers.resize(m_ResId.load(std::memory_order_relaxed), UserList{m_Resource});
+        }
+        // The first use recorded in the own layer copies the users recorded by the sealed layers
+        auto& users = ownUsers[resId];
+        if (users.empty())
+        {
+            if (const auto shared = FindUsers(m_Layers.size() - 1, resId))
+            {
+                users = *shared;
+            }
+        }
+        // Operands referring to the same definition are recorded once
+        if (users.empty() || users.back() != &user)
+        {
+            users.push_back(&user);
+        }
+    }
+}
+
+void Module::RemoveUses(const Instruction& user)
+{
+    for (const Operand& operand : user.m_Operands)
+    {
+        if (operand.GetType() != INSTRUCTION_POINTER || !operand.GetInstructionPtr()->HasResId())
+        {
+            continue;
+        }
+        const auto resId = operand.GetInstructionPtr()->GetResId();
+        if (resId < m_OwnLayer->m_Users.size())
         {
-            operand = Operand{m_ResId++, RES_ID};
-            break;
+            auto& users = m_OwnLayer->m_Users[resId];
+            users.erase(std::remove(users.begin(), users.end(), &user), users.end());
         }
     }
-    return Operand{&(*m_SPIRVGraph.emplace(std::move(inst)))};
 }
 
 } // namespace tfsc::spirv
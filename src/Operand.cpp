@@ -7,163 +7,82 @@
 #include <spirv/Operand.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace tfsc::spirv
 {
 
-uint32_t Operand::WordSize() const
-{
-    switch (m_Type)
-    {
-        case INSTRUCTION_POINTER:
-        case RES_ID:
-        case LITERAL_WORD: return 1;
-        case LITERAL_STRING:
-            // Get the string size accounting for the terminating null character.
-            return static_cast<uint32_t>((m_LiteralStr->size() + 4) / 4);
-        default: return 0;
-    }
-}
-
-bool Operand::operator<(const Operand& other) const
-{
-    if (m_Type != other.m_Type)
-    {
-        return m_Type < other.m_Type;
-    }
-    switch (m_Type)
-    {
-        case INSTRUCTION_POINTER: return m_InstructionPtr < other.m_InstructionPtr;
-        case RES_ID:
-        case LITERAL_WORD: return m_LiteralWord < other.m_LiteralWord;
-        case LITERAL_STRING: return *m_LiteralStr < *other.m_LiteralStr;
-        default:; return false;
-    }
-}
+static_assert(sizeof(Operand) == 8, "Operand must fit in a single 64-bit word");
+static_assert(std::is_trivially_copyable_v<Operand>, "Operand must be trivially copyable");
+static_assert(alignof(LiteralString) >= 8, "LiteralString alignment must leave room for the type bits");
 
-bool Operand::operator==(const Operand& rhs) const
+LiteralString::LiteralString(const std::string_view str, std::pmr::memory_resource* resource)
+    : m_String(str, resource)
+    , m_Words(m_String.size() / 4 + 1, 0u, resource)
+    , m_Hash(std::hash<std::string_view>{}(str))
 {
-    if (m_Type != rhs.m_Type)
-    {
-        return false;
-    }
-    switch (m_Type)
+    // Pack the characters little-endian into words, the zero-initialized tail holds the null terminator and padding
+    for (std::size_t idx = 0; idx < m_String.size(); ++idx)
     {
-        case INSTRUCTION_POINTER: return this->m_InstructionPtr == rhs.m_InstructionPtr;
-        case RES_ID:
-        case LITERAL_WORD: return this->m_LiteralWord == rhs.m_LiteralWord;
-        case LITERAL_STRING: return *this->m_LiteralStr == *rhs.m_LiteralStr;
-        default:; return false;
+        m_Words[idx / 4] |= static_cast<uint32_t>(static_cast<unsigned char>(m_String[idx])) << (8 * (idx % 4));
     }
 }
 
-// Copy Constructor
-Operand::Operand(const Operand& rhs) noexcept
+uint32_t Operand::WordSize() const
 {
-    this->m_Type = rhs.m_Type;
-    switch (m_Type)
+    switch (GetType())
     {
-        case INSTRUCTION_POINTER: this->m_InstructionPtr = rhs.m_InstructionPtr; break;
+        case INSTRUCTION_POINTER:
         case RES_ID:
-        case LITERAL_WORD: this->m_LiteralWord = rhs.m_LiteralWord; break;
-        case LITERAL_STRING: this->m_LiteralStr = new auto(*rhs.m_LiteralStr); break;
-        default:;
+        case LITERAL_WORD: return 1;
+        case LITERAL_STRING: return static_cast<uint32_t>(GetLiteralString().GetWords().size());
+        default: return 0;
     }
 }
 
-// Copy Assignment
-Operand& Operand::operator=(const Operand& other)
+std::size_t Operand::Hash() const
 {
-    // Prevent self assignment
-    if (this == &other)
-    {
-        return *this;
-    }
-
-    if (m_Type == LITERAL_STRING)
+    switch (GetType())
     {
-        delete m_LiteralStr;
+        case LITERAL_STRING: return std::hash<int>{}(LITERAL_STRING) ^ GetLiteralString().GetHash();
+        case RES_ID: return std::hash<int>{}(RES_ID);
+        default: return std::hash<uint64_t>{}(m_Bits);
     }
-
-    this->m_Type = other.m_Type;
-    switch (m_Type)
-    {
-        case INSTRUCTION_POINTER: m_InstructionPtr = other.m_InstructionPtr; break;
-        case UNINITIALIZED:
-        case RES_ID:
-        case LITERAL_WORD: m_LiteralWord = other.m_LiteralWord; break;
-        case LITERAL_STRING: m_LiteralStr = new auto(*other.m_LiteralStr); break;
-        default:;
-    }
-    return *this;
 }
 
-// Move Assignment Operator
-Operand& Operand::operator=(Operand&& rhs) noexcept
+bool Operand::operator<(const Operand& other) const
 {
-    // Prevent self assignment
-    if (this == &rhs)
-    {
-        return *this;
-    }
-
-    if (m_Type == LITERAL_STRING)
+    const auto type = GetType();
+    if (type != other.GetType())
     {
-        delete m_LiteralStr;
+        return type < other.GetType();
     }
-
-    this->m_Type = rhs.m_Type;
-    switch (m_Type)
+    if (type == LITERAL_STRING)
     {
-        case INSTRUCTION_POINTER:
-            m_InstructionPtr = rhs.m_InstructionPtr;
-            rhs.m_InstructionPtr = nullptr;
-            break;
-        case UNINITIALIZED:
-        case RES_ID:
-        case LITERAL_WORD:
-            m_LiteralWord = rhs.m_LiteralWord;
-            rhs.m_LiteralWord = 0;
-            break;
-        case LITERAL_STRING:
-            m_LiteralStr = rhs.m_LiteralStr;
-            rhs.m_LiteralStr = nullptr;
-            break;
-        default:;
+        // Strings interned by the same Module share a payload, only distinct strings need comparing by value
+        return m_Bits != other.m_Bits && GetLiteralStr() < other.GetLiteralStr();
     }
-    return *this;
+    // Pointers and words are ordered by value, which the shared type bits do not affect
+    return type != UNINITIALIZED && m_Bits < other.m_Bits;
 }
 
-// Move Constructor
-Operand::Operand(Operand&& rhs) noexcept
+bool Operand::operator==(const Operand& rhs) const
 {
-    this->m_Type = rhs.m_Type;
-    switch (m_Type)
+    const auto type = GetType();
+    if (type != rhs.GetType() || type == UNINITIALIZED)
     {
-        case INSTRUCTION_POINTER:
-            m_InstructionPtr = rhs.m_InstructionPtr;
-            rhs.m_InstructionPtr = nullptr;
-            break;
-        case RES_ID:
-        case LITERAL_WORD:
-            m_LiteralWord = rhs.m_LiteralWord;
-            rhs.m_LiteralWord = 0;
-            break;
-        case LITERAL_STRING:
-            m_LiteralStr = rhs.m_LiteralStr;
-            rhs.m_LiteralStr = nullptr;
-            break;
-        default:;
+        return false;
     }
-}
-
-Operand::~Operand()
-{
-    if (m_Type == LITERAL_STRING)
+    if (type == LITERAL_STRING)
     {
-        delete m_LiteralStr;
+        // Payloads from different Modules may hold the same string, the precomputed hashes rule out most mismatches
+        return m_Bits == rhs.m_Bits || (GetLiteralString().GetHash() == rhs.GetLiteralString().GetHash() &&
+                                         GetLiteralStr() == rhs.GetLiteralStr());
     }
+    return m_Bits == rhs.m_Bits;
 }
 
-} // namespace tfsc::spirv
\ No newline at end of file
+} // namespace tfsc::spirv
@@ -6,6 +6,7 @@
 #include <SPIRVDefinitions.hpp>
 
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 
 namespace tfsc::spirv
@@ -14,7 +15,14 @@ namespace tfsc::spirv
 using namespace spv;
 using namespace tfsc::tosa;
 
-Operand CreateDataType(const DataType datatype, Module& module)
+/// Kinds of the keys types are cached under in the Module, combined with the data type, see Module::FindCachedType
+enum TypeCacheTag : uint32_t
+{
+    DataTypeTag = 0,
+    TensorTag = 1U << 16,
+};
+
+static Operand EmplaceDataType(const DataType datatype, Module& module)
 {
     using tosa::DataType;
     switch (datatype)
@@ -40,15 +48,39 @@ Operand CreateDataType(const DataType datatype, Module& module)
     }
 }
 
+Operand CreateDataType(const DataType datatype, Module& module)
+{
+    const auto tag = DataTypeTag | static_cast<uint32_t>(datatype);
+    if (const auto cached = module.FindCachedType(tag, nullptr, 0))
+    {
+        return Operand{cached};
+    }
+    const auto type = EmplaceDataType(datatype, module);
+    module.CacheType(tag, nullptr, 0, type.GetInstructionPtr());
+    return type;
+}
+
 Operand CreateConstant(const uint32_t value, const DataType dataType, Module& module)
 {
+    const auto tag = static_cast<uint32_t>(dataType);
+    if (const auto pooled = module.FindPooledConstant(tag, value))
+    {
+        return Operand{pooled};
+    }
+
     auto constTypeId = CreateDataType(dataType, module);
+    Operand constant;
     if (dataType == DataType::bool_t)
     {
         const auto opConstant = value != 0 ? OpConstantTrue : OpConstantFalse;
-        return module.EmplaceInstruction(opConstant, {constTypeId, RESID});
+        constant = module.EmplaceInstruction(opConstant, {constTypeId, RESID});
     }
-    return module.EmplaceInstruction(OpConstant, {constTypeId, RESID, Operand{value}});
+    else
+    {
+        constant = module.EmplaceInstruction(OpConstant, {constTypeId, RESID, Operand{value}});
+    }
+    module.PoolConstant(tag, value, constant.GetInstructionPtr());
+    return constant;
 }
 
 Operand CreateConstantDouble(const uint32_t valueLow, const uint32_t valueHigh, Module& module)
@@ -57,13 +89,90 @@ Operand CreateConstantDouble(const uint32_t valueLow, const uint32_t valueHigh,
     return module.EmplaceInstruction(OpConstant, {constTypeId, RESID, Operand{valueLow}, Operand{valueHigh}});
 }
 
+/// Append the Operands of the scalar constants of an array, emplaced in batches
+/// Each element spans wordsPerElement words, at most 2, which the OpConstant of the element holds in order.
+/// Single-word elements already in the Module's constant pool are not emplaced again.
+static void AppendConstants(const std::vector<uint32_t>& array,
+                            const DataType dataType,
+                            const std::size_t wordsPerElement,
+                            Module& module,
+                            std::vector<Operand>& operands)
+{
+    // Batches are small enough for their descriptors and operands to stay on the stack
+    constexpr std::size_t batchSize = 256;
+    constexpr std::size_t maxOperandsPerElement = 4;
+    std::array<InstructionDescriptor, batchSize> descriptors;
+    std::array<Operand, batchSize * maxOperandsPerElement> constantOperands;
+    std::array<Operand, batchSize> constants;
+    // Index within the batch of the element of each descriptor
+    std::array<std::size_t, batchSize> elements;
+
+    const auto tag = static_cast<uint32_t>(dataType);
+    const bool pooled = wordsPerElement == 1;
+    const auto constTypeId = CreateDataType(dataType, module);
+    const auto elementCount = array.size() / wordsPerElement;
+    operands.reserve(operands.size() + elementCount);
+    for (std::size_t batchBegin = 0; batchBegin < elementCount; batchBegin += batchSize)
+    {
+        const auto batchCount = std::min(batchSize, elementCount - batchBegin);
+        const auto first = operands.size();
+        operands.resize(first + batchCount);
+        std::size_t descriptorCount = 0;
+        for (std::size_t idx = 0; idx < batchCount; ++idx)
+        {
+            const auto* word = array.data() + (batchBegin + idx) * wordsPerElement;
+            if (pooled)
+            {
+                if (const auto constant = module.FindPooledConstant(tag, *word))
+                {
+                    operands[first + idx] = Operand{constant};
+                    continue;
+                }
+            }
+
+            auto* constant = constantOperands.data() + descriptorCount * maxOperandsPerElement;
+            constant[0] = constTypeId;
+            constant[1] = RESID;
+            auto opConstant = OpConstant;
+            std::size_t operandCount = 2;
+            if (dataType == DataType::bool_t)
+            {
+                opConstant = *word != 0 ? OpConstantTrue : OpConstantFalse;
+            }
+            else
+            {
+                for (; operandCount < wordsPerElement + 2; ++operandCount)
+                {
+                    constant[operandCount] = Operand{*word++};
+                }
+            }
+            descriptors[descriptorCount] = {opConstant, constant, operandCount};
+            elements[descriptorCount++] = idx;
+        }
+
+        module.EmplaceInstructions(descriptors.data(), descriptorCount, constants.data());
+        for (std::size_t idx = 0; idx < descriptorCount; ++idx)
+        {
+            operands[first + elements[idx]] = constants[idx];
+            if (pooled)
+            {
+                const auto value = array[batchBegin + elements[idx]];
+                module.PoolConstant(tag, value, constants[idx].GetInstructionPtr());
+            }
+        }
+    }
+}
+
 Operand CreateConstantComposite(const std::vector<uint32_t>& array,
                                 const Operand& resultType,
                                 Module& module,
                                 tosa::DataType constituentType,
                                 const bool tryReduce)
 {
-    std::vector operands{resultType, RESID};
+    std::vector<Operand> operands;
+    operands.reserve(array.size() + 2);
+    operands.push_back(resultType);
+    operands.push_back(RESID);
 
     if (array.empty())
     {
@@ -72,14 +181,7 @@ Operand CreateConstantComposite(const std::vector<uint32_t>& array,
 
     if (constituentType == DataType::int48_t)
     {
-        auto constTypeId = CreateDataType(DataType::int48_t, module);
-        for (auto val = array.begin(); val != array.end();)
-        {
-            const auto low = *val++;
-            const auto high = *val++;
-            operands.emplace_back(
-                module.EmplaceInstruction(OpConstant, {constTypeId, RESID, Operand{low}, Operand{high}}));
-        }
+        AppendConstants(array, DataType::int48_t, 2, module, operands);
         return module.EmplaceInstruction(OpConstantComposite, operands);
     }
 
@@ -102,22 +204,29 @@ Operand CreateConstantComposite(const std::vector<uint32_t>& array,
         }
     }
 
-    for (const auto val : array)
-    {
-        operands.push_back(CreateConstant(val, constituentType, module));
-    }
+    AppendConstants(array, constituentType, 1, module, operands);
     return module.EmplaceInstruction(OpConstantComposite, operands);
 }
 
 Operand CreateTensor(const Tensor& tensor, Module& module)
 {
+    // Tensors of a data type and shape seen before are found without emplacing any of their Instructions again
+    const auto& shape = tensor.GetTensorShape();
+    const auto tag = TensorTag | static_cast<uint32_t>(tensor.GetDataType());
+    if (const auto cached = module.FindCachedType(tag, shape.data(), shape.size()))
+    {
+        return Operand{cached};
+    }
+
     const Operand rankValue(static_cast<unsigned int>(tensor.GetTensorShape().size()));
     const auto U32Type = CreateDataType(DataType::uint32_t, module);
     const auto dataType = CreateDataType(tensor.GetDataType(), module);
     const auto tensorRank = module.EmplaceInstruction(OpConstant, {U32Type, RESID, rankValue});
     const auto arrayTypeId = module.EmplaceInstruction(OpTypeArray, {RESID, U32Type, tensorRank});
     const auto TensorShapeId = CreateConstantComposite(tensor.GetTensorShape(), arrayTypeId, module);
-    return module.EmplaceInstruction(OpTypeTensorARM, {RESID, dataType, tensorRank, TensorShapeId});
+    const auto tensorType = module.EmplaceInstruction(OpTypeTensorARM, {RESID, dataType, tensorRank, TensorShapeId});
+    module.CacheType(tag, shape.data(), shape.size(), tensorType.GetInstructionPtr());
+    return tensorType;
 }
 
 Operand CreateAttribute(const Attribute& attribute, Module& module)
@@ -3,15 +3,20 @@
 // SPDX-License-Identifier: Apache-2.0
 //
 
+#include <BinarySink.hpp>
+#include <EmissionOrder.hpp>
 #include <Module.hpp>
 #include <algorithm>
 #include <iostream>
 #include <TosaForSpirvCodegen.hpp>
 
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <ostream>
-#include <unordered_set>
+#include <stdexcept>
+#include <thread>
 
 namespace tfsc::spirv
 {
@@ -25,7 +30,12 @@ using namespace spirv;
 
 std::shared_ptr<Module> CreateModule(TOSAVersion version)
 {
-    auto module = std::make_unique<Module>();
+    return CreateModule(version, ModuleOptions{});
+}
+
+std::shared_ptr<Module> CreateModule(TOSAVersion version, const ModuleOptions& options)
+{
+    auto module = std::make_unique<Module>(options);
 
     module->EmplaceInstruction(OpCapability, {Operand{CapabilityVulkanMemoryModel}});
     module->EmplaceInstruction(OpCapability, {Operand{CapabilityShader}});
@@ -37,12 +47,12 @@ std::shared_ptr<Module> CreateModule(TOSAVersion version)
     module->EmplaceInstruction(OpCapability, {Operand{CapabilityTensorsARM}});
     module->EmplaceInstruction(OpCapability, {Operand{CapabilityReplicatedCompositesEXT}});
 
-    module->EmplaceInstruction(OpExtension, {Operand{"SPV_ARM_graph"}});
-    module->EmplaceInstruction(OpExtension, {Operand{"SPV_ARM_tensors"}});
-    module->EmplaceInstruction(OpExtension, {Operand{"SPV_EXT_replicated_composites"}});
+    module->EmplaceInstruction(OpExtension, {module->EmplaceString("SPV_ARM_graph")});
+    module->EmplaceInstruction(OpExtension, {module->EmplaceString("SPV_ARM_tensors")});
+    module->EmplaceInstruction(OpExtension, {module->EmplaceString("SPV_EXT_replicated_composites")});
 
     const std::string versionStr = "TOSA.001000.1";
-    module->EmplaceInstruction(OpExtInstImport, {RESID, Operand{versionStr}});
+    module->EmplaceInstruction(OpExtInstImport, {RESID, module->EmplaceString(versionStr)});
 
     module->EmplaceInstruction(OpMemoryModel, {Operand(AddressingModelLogical), Operand(MemoryModelVulkan)});
 
@@ -50,282 +60,786 @@ std::shared_ptr<Module> CreateModule(TOSAVersion version)
 }
 
 constexpr int32_t GetMinorVersion();
-unsigned int GetResId(const Instruction& instruction);
-void WriteOperand(const Operand& operand, std::vector<uint32_t>& binary);
-void WriteInstruction(const Instruction& instruction, std::vector<uint32_t>& binary);
-void WriteInstructionsRecursive(const Instruction* instruction,
-                                std::vector<uint32_t>& binary,
-                                std::set<unsigned int>& visitedInstructions);
+
+/// Number of words in the header of a SPIR-V module
+constexpr std::size_t HeaderWordCount = 5;
+
+/// Result ids written to the binary, indexed by the result id assigned by the Module.
+/// Empty when the Module's result ids are written unchanged.
+using ResIdMap = std::vector<uint32_t>;
+
+std::size_t GetBinarySizeInWords(const EmissionOrder& order);
+uint32_t PrepareResIds(const std::shared_ptr<Module>& module,
+                       const EmissionOrder& order,
+                       const BinaryWriterOptions& options,
+                       ResIdMap& resIdMap);
+uint32_t* WriteHeader(uint32_t bound, uint32_t* binary);
+uint32_t* WriteInstruction(const Instruction& instruction, uint32_t* binary, const uint32_t* resIdMap);
+uint32_t* WriteOperand(const Operand& operand, uint32_t* binary, const uint32_t* resIdMap);
+
+/// Pending Instruction of the dependency walk and the index of the next operand to visit
+struct DependencyFrame
+{
+    const Instruction* m_Instruction;
+    std::size_t m_NextOperand;
+};
+
+/// Marks result ids as written, indexed densely by result id.
+/// Instructions without a result id share id 0, as only the first of them reaches the dependency walk.
+using VisitedResIds = std::vector<bool>;
+
+void AppendInstructionWithDependencies(const Instruction* instruction,
+                                       EmissionOrder& order,
+                                       VisitedResIds& visitedInstructions,
+                                       std::vector<DependencyFrame>& stack);
 
 std::vector<uint32_t> WriteToBinary(const std::shared_ptr<Module>& module)
 {
-    std::vector<uint32_t> binary;
-    const auto spirv = module->GetSpirvGraph();
-    std::set<unsigned int> visitedInstructions;
+    return WriteToBinary(module, BinaryWriterOptions{});
+}
 
-    auto writeInstructionsOfType = [&](const Op op) {
-        const auto [begin, end] = module->GetInstructionsOfType(op);
-        for (auto it = begin; it != end; ++it)
+std::vector<uint32_t> WriteToBinary(const std::shared_ptr<Module>& module, const BinaryWriterOptions& options)
+{
+    const auto order = GetEmissionOrder(*module);
+    ResIdMap resIdMap;
+    const auto bound = PrepareResIds(module, order, options, resIdMap);
+    // Allocate the exact size once, then fill it in place
+    std::vector<uint32_t> binary(GetBinarySizeInWords(order));
+    uint32_t* const body = WriteHeader(bound, binary.data());
+
+    const uint32_t* resIds = resIdMap.empty() ? nullptr : resIdMap.data();
+    const auto writeRange = [&order, resIds](const std::size_t first, const std::size_t last, uint32_t* cursor) {
+        for (auto idx = first; idx < last; ++idx)
+        {
+            cursor = WriteInstruction(*order[idx], cursor, resIds);
+        }
+    };
+
+    const std::size_t threadCount =
+        std::min<std::size_t>(options.m_ThreadCount == 0 ? std::max(std::thread::hardware_concurrency(), 1u)
+                                                         : options.m_ThreadCount,
+                              order.size() / std::max<std::size_t>(options.m_MinInstructionsPerThread, 1));
+    if (threadCount <= 1)
+    {
+        writeRange(0, order.size(), body);
+        return binary;
+    }
+
+    // Split the Instructions into ranges of similar word counts, each encoded at its precomputed offset
+    const auto bodyWordCount = static_cast<std::size_t>(binary.data() + binary.size() - body);
+    std::vector<std::size_t> rangeBegins{0};
+    std::vector<std::size_t> rangeOffsets{0};
+    std::size_t offset = 0;
+    for (std::size_t idx = 0; idx < order.size(); ++idx)
+    {
+        if (offset >= rangeBegins.size() * bodyWordCount / threadCount && idx != rangeBegins.back())
+        {
+            rangeBegins.push_back(idx);
+            rangeOffsets.push_back(offset);
+        }
+        offset += order[idx]->m_WordCount;
+    }
+    rangeBegins.push_back(order.size());
+
+    std::vector<std::thread> threads;
+    const auto joinThreads = [&threads]() {
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    };
+    try
+    {
+        for (std::size_t range = 1; range + 1 < rangeBegins.size(); ++range)
+        {
+            threads.emplace_back(writeRange, rangeBegins[range], rangeBegins[range + 1], body + rangeOffsets[range]);
+        }
+    }
+    catch (...)
+    {
+        // Do not leave joinable threads behind if one fails to start
+        joinThreads();
+        throw;
+    }
+    writeRange(rangeBegins[0], rangeBegins[1], body);
+    joinThreads();
+    return binary;
+}
+
+void WriteToBinary(const std::shared_ptr<Module>& module, BinarySink& sink, const BinaryWriterOptions& options)
+{
+    // A word count is encoded in 16 bits, so any well-formed Instruction fits in a single chunk
+    constexpr std::size_t ChunkWordCount = 1 << 16;
+
+    const auto order = GetEmissionOrder(*module);
+    ResIdMap resIdMap;
+    const auto bound = PrepareResIds(module, order, options, resIdMap);
+    const uint32_t* resIds = resIdMap.empty() ? nullptr : resIdMap.data();
+
+    std::vector<uint32_t> chunk(ChunkWordCount);
+    uint32_t* cursor = WriteHeader(bound, chunk.data());
+    for (const Instruction* instruction : order)
+    {
+        if (instruction->m_WordCount > static_cast<std::size_t>(chunk.data() + chunk.size() - cursor))
+        {
+            sink.Write(chunk.data(), static_cast<std::size_t>(cursor - chunk.data()));
+            chunk.resize(std::max<std::size_t>(chunk.size(), instruction->m_WordCount));
+            cursor = chunk.data();
+        }
+        cursor = WriteInstruction(*instruction, cursor, resIds);
+    }
+    sink.Write(chunk.data(), static_cast<std::size_t>(cursor - chunk.data()));
+}
+
+std::vector<uint32_t> WriteToBinary(const FrozenModule& module)
+{
+    std::size_t wordCount = HeaderWordCount;
+    for (const auto instructionWordCount : module.m_WordCounts)
+    {
+        wordCount += instructionWordCount;
+    }
+    std::vector<uint32_t> binary(wordCount);
+    uint32_t* cursor = WriteHeader(module.m_ResIdBound, binary.data());
+
+    for (std::size_t idx = 0; idx < module.GetInstructionCount(); ++idx)
+    {
+        *cursor++ = (module.m_WordCounts[idx] << 16) | static_cast<uint32_t>(module.m_Opcodes[idx]);
+        for (auto operand = module.m_OperandOffsets[idx]; operand < module.m_OperandOffsets[idx + 1]; ++operand)
+        {
+            const auto value = module.m_OperandValues[operand];
+            switch (module.m_OperandTypes[operand])
+            {
+                case LITERAL_WORD: *cursor++ = value; break;
+                case RES_ID:
+                case INSTRUCTION_POINTER: *cursor++ = module.m_ResIds[value]; break;
+                case LITERAL_STRING:
+                {
+                    const auto first = module.m_StringWords.begin() + module.m_StringOffsets[value];
+                    const auto last = module.m_StringWords.begin() + module.m_StringOffsets[value + 1];
+                    cursor = std::copy(first, last, cursor);
+                    break;
+                }
+                default: break;
+            }
+        }
+    }
+    return binary;
+}
+
+std::size_t GetBinarySizeInWords(const std::shared_ptr<Module>& module)
+{
+    return GetBinarySizeInWords(GetEmissionOrder(*module));
+}
+
+std::size_t GetBinarySizeInWords(const EmissionOrder& order)
+{
+    std::size_t wordCount = HeaderWordCount;
+    for (const Instruction* instruction : order)
+    {
+        wordCount += instruction->m_WordCount;
+    }
+    return wordCount;
+}
+
+uint32_t PrepareResIds(const std::shared_ptr<Module>& module,
+                       const EmissionOrder& order,
+                       const BinaryWriterOptions& options,
+                       ResIdMap& resIdMap)
+{
+    if (!options.m_CompactResIds)
+    {
+        // Instructions removed from the Module may leave result ids above the Instruction count
+        return std::max(static_cast<uint32_t>(module->GetSpirvGraph().size()), module->GetResIdBound());
+    }
+
+    // Number the written Instructions 1, 2, 3... in the order they are written
+    resIdMap.assign(module->GetResIdBound(), 0);
+    uint32_t nextResId = 1;
+    for (const Instruction* instruction : order)
+    {
+        if (instruction->HasResId() && resIdMap[instruction->GetResId()] == 0)
+        {
+            resIdMap[instruction->GetResId()] = nextResId++;
+        }
+    }
+    return nextResId;
+}
+
+/// Whether an Instruction is kept by EliminateDeadInstructions regardless of its users
+bool IsLivenessRoot(const spv::Op opCode)
+{
+    switch (opCode)
+    {
+        case OpCapability:
+        case OpExtension:
+        case OpExtInstImport:
+        case OpMemoryModel:
+        case OpVariable:
+        case OpTypeGraphARM:
+        case OpGraphEntryPointARM:
+        case OpGraphARM:
+        case OpGraphInputARM:
+        case OpGraphSetOutputARM:
+        case OpGraphEndARM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+DeadInstructionReport EliminateDeadInstructions(const std::shared_ptr<Module>& module)
+{
+    // Mark the Instructions reachable from the roots, indexed by result id
+    std::vector<bool> live(module->GetResIdBound(), false);
+    std::vector<const Instruction*> worklist;
+    const auto markLive = [&](const Instruction* instruction) {
+        if (instruction->HasResId())
+        {
+            if (live[instruction->GetResId()])
+            {
+                return;
+            }
+            live[instruction->GetResId()] = true;
+        }
+        worklist.push_back(instruction);
+    };
+
+    for (const Instruction& instruction : module->GetSpirvGraph())
+    {
+        if (IsLivenessRoot(instruction.m_Opcode))
+        {
+            markLive(&instruction);
+        }
+    }
+    while (!worklist.empty())
+    {
+        const Instruction* instruction = worklist.back();
+        worklist.pop_back();
+        for (const Operand& operand : instruction->m_Operands)
+        {
+            if (operand.GetType() == INSTRUCTION_POINTER)
+            {
+                markLive(operand.GetInstructionPtr());
+            }
+        }
+    }
+
+    // Instructions the writer never emits, e.g. unused constants, do not count towards the saved bytes. The graphs
+    // are not split, which emits the same Instructions even if an operator is part of several graphs.
+    const auto getEmittedWords = [&module]() { return GetBinarySizeInWords(GetEmissionOrder(*module, false, false)); };
+    const auto emittedWordsBefore = getEmittedWords();
+
+    // Decorations are kept with their target, every other Instruction without a result id is a root
+    DeadInstructionReport report;
+    const auto isDead = [&live](const Instruction& instruction) {
+        if (instruction.m_Opcode == OpDecorate)
         {
-            WriteInstruction(*it, binary);
-            visitedInstructions.emplace(GetResId(*it));
+            return !live[instruction.m_Operands[0].GetInstructionPtr()->GetResId()];
         }
+        return instruction.HasResId() && !live[instruction.GetResId()];
     };
+    report.m_RemovedInstructions = module->EraseInstructionsIf(isDead);
+    report.m_SavedBytes = (emittedWordsBefore - getEmittedWords()) * sizeof(uint32_t);
+    return report;
+}
+
+LinkResult LinkModules(const std::shared_ptr<Module>& destination, const std::shared_ptr<Module>& source)
+{
+    if (destination == source)
+    {
+        throw std::runtime_error("LinkModules: a Module cannot be linked into itself");
+    }
 
-    auto writeInstructionsOfTypeRecursive = [&visitedInstructions, &module, &binary](const Op op) {
-        const auto [begin, end] = module->GetInstructionsOfType(op);
+    const auto nextGraphConstantId = [](const Module& module) {
+        uint32_t nextId = 0;
+        const auto [begin, end] = module.GetInstructionsOfType(OpGraphConstantARM);
         for (auto it = begin; it != end; ++it)
         {
-            WriteInstructionsRecursive(&(*it), binary, visitedInstructions);
+            nextId = std::max(nextId, it->m_Operands[2].GetLiteralWord() + 1);
         }
+        return nextId;
     };
+    LinkResult result;
+    result.m_GraphConstantOffset = std::max(nextGraphConstantId(*destination), destination->GetGraphConstantIdBound());
+
+    // Operands only refer to Instructions emplaced before them, which have lower result ids, so importing in result id
+    // order imports the Instructions an Instruction refers to first. Instructions without a result id cannot be
+    // referred to and are imported last, in their order in the source.
+    std::vector<const Instruction*> order;
+    order.reserve(source->GetSpirvGraph().size());
+    for (const Instruction& instruction : source->GetSpirvGraph())
+    {
+        order.push_back(&instruction);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const Instruction* lhs, const Instruction* rhs) {
+        return lhs->HasResId() && (!rhs->HasResId() || lhs->GetResId() < rhs->GetResId());
+    });
 
-    auto sortThenWriteInstructions =
-        [&](const Op opType, const std::function<bool(const Instruction& lhs, const Instruction& rhs)>& comparator) {
-            const auto [instructionBegin, instructionEnd] = module->GetInstructionsOfType(opType);
-            std::vector<Instruction> instructions{instructionBegin, instructionEnd};
-            std::sort(begin(instructions), end(instructions), comparator);
-            std::for_each(begin(instructions), end(instructions), [&](const Instruction& inst) {
-                WriteInstruction(inst, binary);
-                visitedInstructions.emplace(GetResId(inst));
-            });
-        };
+    std::size_t operandCount = 0;
+    for (const Instruction* instruction : order)
+    {
+        operandCount += instruction->m_Operands.size();
+    }
+    destination->Reserve(order.size(), operandCount);
 
-    // Sort a range of instructions by the given comparator and then write them
-    auto sortThenWriteInstructionsRecursive =
-        [&](const Op opType, const std::function<bool(const Instruction& lhs, const Instruction& rhs)>& comparator) {
-            const auto [instructionBegin, instructionEnd] = module->GetInstructionsOfType(opType);
-            std::vector<Instruction> instructions{instructionBegin, instructionEnd};
-            std::sort(begin(instructions), end(instructions), comparator);
-            std::for_each(begin(instructions), end(instructions), [&](const Instruction& inst) {
-                WriteInstructionsRecursive(&inst, binary, visitedInstructions);
-                visitedInstructions.emplace(GetResId(inst));
-            });
-        };
+    const auto sizeBefore = destination->GetSpirvGraph().size();
+    result.m_Instructions.reserve(order.size());
+    std::vector<Operand> operands;
+    for (const Instruction* instruction : order)
+    {
+        operands.clear();
+        for (const Operand& operand : instruction->m_Operands)
+        {
+            switch (operand.GetType())
+            {
+                case INSTRUCTION_POINTER:
+                    operands.emplace_back(result.m_Instructions.at(operand.GetInstructionPtr()));
+                    break;
+                case LITERAL_STRING: operands.push_back(destination->EmplaceString(operand.GetLiteralStr())); break;
+                case RES_ID: operands.push_back(RESID); break;
+                default: operands.push_back(operand); break;
+            }
+        }
+        if (instruction->m_Opcode == OpGraphConstantARM)
+        {
+            operands[2] = Operand{operands[2].GetLiteralWord() + result.m_GraphConstantOffset};
+        }
+
+        // Variables and the Instructions delimiting a graph are distinct even when their operands match,
+        // see tosa::Graph
+        const auto opCode = instruction->m_Opcode;
+        const bool distinct =
+            opCode == OpVariable || opCode == OpGraphARM || opCode == OpGraphInputARM || opCode == OpGraphEndARM;
+        const auto linked = distinct ? destination->EmplaceInstructionNonUnique(opCode, operands)
+                                     : destination->EmplaceInstruction(opCode, operands);
+        result.m_Instructions.emplace(instruction, linked.GetInstructionPtr());
+    }
 
-    const auto sortByResId = [](const Instruction& lhs, const Instruction& rhs) {
-        return GetResId(lhs) < GetResId(rhs);
+    const auto linkAll = [&result](const std::vector<const Instruction*>& instructions) {
+        std::vector<const Instruction*> linked;
+        linked.reserve(instructions.size());
+        for (const Instruction* instruction : instructions)
+        {
+            linked.push_back(result.m_Instructions.at(instruction));
+        }
+        return linked;
     };
+    for (const auto& graph : source->GetGraphDefinitions())
+    {
+        destination->AddGraphDefinition({result.m_Instructions.at(graph.m_Graph),
+                                         linkAll(graph.m_Inputs),
+                                         linkAll(graph.m_Outputs),
+                                         result.m_Instructions.at(graph.m_End)});
+    }
+    result.m_ImportedInstructions = destination->GetSpirvGraph().size() - sizeBefore;
+    destination->ReserveGraphConstantIds(nextGraphConstantId(*destination));
+    result.m_NextGraphConstantId = destination->GetGraphConstantIdBound();
+    return result;
+}
 
-    binary.push_back(MagicNumber);
-    const uint32_t version = (1 << 16) | (GetMinorVersion() << 8);
-    binary.push_back(version);
+EmissionOrder GetEmissionOrder(const Module& module, const bool reportUnwritten, const bool splitGraphs)
+{
+    EmissionOrder order;
+    order.reserve(module.GetSpirvGraph().size());
+    const auto& spirv = module.GetSpirvGraph();
+    VisitedResIds visitedInstructions(module.GetResIdBound(), false);
+    std::vector<DependencyFrame> dependencyStack;
+    const auto writeInstructionRecursive = [&](const Instruction* inst) {
+        AppendInstructionWithDependencies(inst, order, visitedInstructions, dependencyStack);
+    };
+    const auto writeInstruction = [&](const Instruction* inst) {
+        order.push_back(inst);
+        visitedInstructions[inst->GetResId()] = true;
+    };
 
-    // Use the ARM vendor ID, which is 5.
-    // This is defined in SPIRV-Headers/include/spirv/spir-v.xml
-    constexpr uint32_t vendor = 5 << 16;
-    binary.push_back(vendor);
+    // The writer only orders pointers to the Instructions owned by the Module, it never copies an Instruction.
+    auto getInstructionsOfType = [&module](const Op op) {
+        const auto [instructionBegin, instructionEnd] = module.GetInstructionsOfType(op);
+        std::vector<const Instruction*> instructions;
+        instructions.reserve(static_cast<std::size_t>(std::distance(instructionBegin, instructionEnd)));
+        for (auto it = instructionBegin; it != instructionEnd; ++it)
+        {
+            instructions.push_back(&(*it));
+        }
+        return instructions;
+    };
 
-    const uint32_t bound = spirv.size();
-    binary.push_back(bound);
-    // Output the schema (reserved for use and must be 0)
-    binary.push_back(0);
+    // The Module keeps Instructions in emplacement order, sort them into the canonical InstructionComparator order
+    // so the binary layout does not depend on the order in which a graph was built.
+    auto getOrderedInstructionsOfType = [&](const Op op) {
+        auto instructions = getInstructionsOfType(op);
+        std::stable_sort(begin(instructions), end(instructions), [](const Instruction* lhs, const Instruction* rhs) {
+            return InstructionComparator{}(*lhs, *rhs);
+        });
+        return instructions;
+    };
+
+    // Sort Instructions by a key computed once per Instruction, keeping the order they come in for equal keys
+    const auto sortByKey = [](std::vector<const Instruction*>& instructions, uint32_t (*getKey)(const Instruction&)) {
+        std::vector<std::pair<uint32_t, const Instruction*>> keyed;
+        keyed.reserve(instructions.size());
+        for (const Instruction* inst : instructions)
+        {
+            keyed.emplace_back(getKey(*inst), inst);
+        }
+        std::stable_sort(begin(keyed), end(keyed), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        std::transform(begin(keyed), end(keyed), begin(instructions), [](const auto& entry) { return entry.second; });
+    };
+
+    auto writeInstructionsOfType = [&](const Op op) {
+        for (const Instruction* inst : getOrderedInstructionsOfType(op))
+        {
+            writeInstruction(inst);
+        }
+    };
+
+    auto writeInstructionsOfTypeRecursive = [&](const Op op) {
+        for (const Instruction* inst : getOrderedInstructionsOfType(op))
+        {
+            writeInstructionRecursive(inst);
+        }
+    };
+
+    auto sortThenWriteInstructions = [&](const Op opType, uint32_t (*getKey)(const Instruction&)) {
+        auto instructions = getOrderedInstructionsOfType(opType);
+        sortByKey(instructions, getKey);
+        std::for_each(begin(instructions), end(instructions), writeInstruction);
+    };
+
+    // Sort a range of instructions by the given key and then write them
+    auto sortThenWriteInstructionsRecursive = [&](const Op opType, uint32_t (*getKey)(const Instruction&)) {
+        auto instructions = getOrderedInstructionsOfType(opType);
+        sortByKey(instructions, getKey);
+        std::for_each(begin(instructions), end(instructions), [&](const Instruction* inst) {
+            writeInstructionRecursive(inst);
+            visitedInstructions[inst->GetResId()] = true;
+        });
+    };
+
+    const auto resIdKey = [](const Instruction& inst) { return inst.GetResId(); };
 
     writeInstructionsOfType(OpCapability);
     writeInstructionsOfType(OpExtension);
     writeInstructionsOfType(OpExtInstImport);
     writeInstructionsOfType(OpMemoryModel);
 
-    sortThenWriteInstructions(OpDecorate, [](const Instruction& lhs, const Instruction& rhs) {
-        return GetResId(*lhs.m_Operands[0].m_InstructionPtr) < GetResId(*rhs.m_Operands[0].m_InstructionPtr);
+    sortThenWriteInstructions(OpDecorate, [](const Instruction& inst) {
+        return inst.m_Operands[0].GetInstructionPtr()->GetResId();
     });
 
-    sortThenWriteInstructionsRecursive(OpVariable, sortByResId);
+    sortThenWriteInstructionsRecursive(OpVariable, resIdKey);
     writeInstructionsOfTypeRecursive(OpGraphConstantARM);
 
-    const auto [inputBegin, inputEnd] = module->GetInstructionsOfType(OpGraphInputARM);
-    // Sort input operators by their ResIds
-    std::vector<Instruction> inputInstructions{inputBegin, inputEnd};
-    std::sort(begin(inputInstructions), end(inputInstructions), [](const Instruction& lhs, const Instruction& rhs) {
-        return lhs.m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord <
-               rhs.m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord;
-    });
+    // Sort input operators by their input index
+    const auto inputIndexKey = [](const Instruction& inst) {
+        return inst.m_Operands[2].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
+    };
+    auto inputInstructions = getInstructionsOfType(OpGraphInputARM);
+    sortByKey(inputInstructions, inputIndexKey);
     // Resolve all dependencies of the inputs
-    for (const auto& input : inputInstructions)
+    for (const Instruction* input : inputInstructions)
     {
-        for (const Operand& operand : input.m_Operands)
+        for (const Operand& operand : input->m_Operands)
         {
-            if (operand.m_Type == INSTRUCTION_POINTER)
+            if (operand.GetType() == INSTRUCTION_POINTER)
             {
-                WriteInstructionsRecursive(operand.m_InstructionPtr, binary, visitedInstructions);
+                writeInstructionRecursive(operand.GetInstructionPtr());
             }
         }
     }
 
     // Resolve all dependencies of the tosa operators
-    const auto [tosaBegin, tosaEnd] = module->GetInstructionsOfType(OpExtInst);
     // Sort tosa operators by their ResIds
-    std::vector<Instruction> TOSAInstructions{tosaBegin, tosaEnd};
-    std::sort(begin(TOSAInstructions), end(TOSAInstructions), [](const Instruction& lhs, const Instruction& rhs) {
-        return lhs.m_Operands[1].m_LiteralWord < rhs.m_Operands[1].m_LiteralWord;
-    });
-    for (const auto& TOSAInstruction : TOSAInstructions)
+    auto TOSAInstructions = getInstructionsOfType(OpExtInst);
+    sortByKey(TOSAInstructions, [](const Instruction& inst) { return inst.m_Operands[1].GetLiteralWord(); });
+    for (const Instruction* TOSAInstruction : TOSAInstructions)
     {
-        for (const Operand& operand : TOSAInstruction.m_Operands)
+        for (const Operand& operand : TOSAInstruction->m_Operands)
         {
-            if (operand.m_Type == INSTRUCTION_POINTER && operand.m_InstructionPtr->m_Opcode != OpExtInst &&
-                operand.m_InstructionPtr->m_Opcode != OpCompositeExtract &&
-                operand.m_InstructionPtr->m_Opcode != OpGraphInputARM)
+            if (operand.GetType() == INSTRUCTION_POINTER && operand.GetInstructionPtr()->m_Opcode != OpExtInst &&
+                operand.GetInstructionPtr()->m_Opcode != OpCompositeExtract &&
+                operand.GetInstructionPtr()->m_Opcode != OpGraphInputARM)
             {
-                WriteInstructionsRecursive(operand.m_InstructionPtr, binary, visitedInstructions);
+                writeInstructionRecursive(operand.GetInstructionPtr());
             }
         }
     }
 
-    const auto [outputBegin, outputEnd] = module->GetInstructionsOfType(OpGraphSetOutputARM);
-    // Sort output operators by their ResIds
-    std::vector<Instruction> outputInstructions{outputBegin, outputEnd};
-    std::sort(begin(outputInstructions), end(outputInstructions), [](const Instruction& lhs, const Instruction& rhs) {
-        return lhs.m_Operands[1].m_InstructionPtr->m_Operands[2].m_LiteralWord <
-               rhs.m_Operands[1].m_InstructionPtr->m_Operands[2].m_LiteralWord;
-    });
+    // Sort output operators by their output index
+    const auto outputIndexKey = [](const Instruction& inst) {
+        return inst.m_Operands[1].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
+    };
+    auto outputInstructions = getInstructionsOfType(OpGraphSetOutputARM);
+    sortByKey(outputInstructions, outputIndexKey);
     // Resolve all dependencies of outputs
-    for (const auto& outputInstruction : outputInstructions)
+    for (const Instruction* outputInstruction : outputInstructions)
     {
-        for (const Operand& operand : outputInstruction.m_Operands)
+        for (const Operand& operand : outputInstruction->m_Operands)
         {
-            if (operand.m_Type == INSTRUCTION_POINTER && operand.m_InstructionPtr->m_Opcode != OpExtInst &&
-                operand.m_InstructionPtr->m_Opcode != OpCompositeExtract &&
-                operand.m_InstructionPtr->m_Opcode != OpGraphSetOutputARM &&
-                operand.m_InstructionPtr->m_Opcode != OpGraphInputARM)
+            if (operand.GetType() == INSTRUCTION_POINTER && operand.GetInstructionPtr()->m_Opcode != OpExtInst &&
+                operand.GetInstructionPtr()->m_Opcode != OpCompositeExtract &&
+                operand.GetInstructionPtr()->m_Opcode != OpGraphSetOutputARM &&
+                operand.GetInstructionPtr()->m_Opcode != OpGraphInputARM)
             {
-                WriteInstructionsRecursive(operand.m_InstructionPtr, binary, visitedInstructions);
+                writeInstructionRecursive(operand.GetInstructionPtr());
             }
         }
     }
 
     writeInstructionsOfType(OpTypeGraphARM);
     writeInstructionsOfType(OpGraphEntryPointARM);
-    writeInstructionsOfType(OpGraphARM);
 
-    std::for_each(inputInstructions.begin(), inputInstructions.end(), [&](const Instruction& inst) {
-        WriteInstruction(inst, binary);
-        visitedInstructions.emplace(GetResId(inst));
-    });
+    const auto& graphs = module.GetGraphDefinitions();
+    if (graphs.size() <= 1 || !splitGraphs)
+    {
+        writeInstructionsOfType(OpGraphARM);
 
-    std::for_each(TOSAInstructions.begin(), TOSAInstructions.end(), [&](const Instruction& inst) {
-        WriteInstruction(inst, binary);
-        visitedInstructions.emplace(GetResId(inst));
-    });
+        std::for_each(inputInstructions.begin(), inputInstructions.end(), writeInstruction);
+        std::for_each(TOSAInstructions.begin(), TOSAInstructions.end(), writeInstruction);
 
-    writeInstructionsOfType(OpCompositeExtract);
-    std::for_each(outputInstructions.begin(), outputInstructions.end(), [&](const Instruction& inst) {
-        WriteInstruction(inst, binary);
-        visitedInstructions.emplace(GetResId(inst));
-    });
+        writeInstructionsOfType(OpCompositeExtract);
+        std::for_each(outputInstructions.begin(), outputInstructions.end(), writeInstruction);
+
+        writeInstructionsOfType(OpGraphEndARM);
+    }
+    else
+    {
+        // The body of each graph is made of the operators and composite extracts that depend on its inputs, or that
+        // its outputs depend on, so operators whose results are unused are written as in a single graph Module
+        constexpr uint32_t NoGraph = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> graphOf(module.GetResIdBound(), NoGraph);
+        const auto assign = [&graphOf](const Instruction* instruction, const uint32_t graph) {
+            auto& owner = graphOf[instruction->GetResId()];
+            if (owner != NoGraph && owner != graph)
+            {
+                throw std::runtime_error("GetEmissionOrder: an operator is part of several graphs");
+            }
+            owner = graph;
+        };
+        const auto isBodyInstruction = [](const Instruction* instruction) {
+            return instruction->m_Opcode == OpExtInst || instruction->m_Opcode == OpCompositeExtract;
+        };
 
-    writeInstructionsOfType(OpGraphEndARM);
+        for (uint32_t graph = 0; graph < graphs.size(); ++graph)
+        {
+            for (const Instruction* input : graphs[graph].m_Inputs)
+            {
+                assign(input, graph);
+            }
+        }
+        // Operands are emplaced before the Instructions using them and so have lower result ids, a single pass in
+        // result id order carries the graph of the inputs forward to every operator depending on them
+        auto body = getInstructionsOfType(OpExtInst);
+        const auto extracts = getInstructionsOfType(OpCompositeExtract);
+        body.insert(body.end(), extracts.begin(), extracts.end());
+        sortByKey(body, resIdKey);
+        for (const Instruction* instruction : body)
+        {
+            for (const Operand& operand : instruction->m_Operands)
+            {
+                if (operand.GetType() != INSTRUCTION_POINTER)
+                {
+                    continue;
+                }
+                const auto dependency = operand.GetInstructionPtr();
+                if ((isBodyInstruction(dependency) || dependency->m_Opcode == OpGraphInputARM) &&
+                    graphOf[dependency->GetResId()] != NoGraph)
+                {
+                    assign(instruction, graphOf[dependency->GetResId()]);
+                }
+            }
+        }
+
+        // Operators computed from constants only belong to the graph whose outputs depend on them
+        VisitedResIds reached(module.GetResIdBound(), false);
+        for (uint32_t graph = 0; graph < graphs.size(); ++graph)
+        {
+            std::vector<const Instruction*> worklist(graphs[graph].m_Outputs.begin(), graphs[graph].m_Outputs.end());
+            while (!worklist.empty())
+            {
+                const Instruction* instruction = worklist.back();
+                worklist.pop_back();
+                for (const Operand& operand : instruction->m_Operands)
+                {
+                    if (operand.GetType() != INSTRUCTION_POINTER || !isBodyInstruction(operand.GetInstructionPtr()))
+                    {
+                        continue;
+                    }
+                    assign(operand.GetInstructionPtr(), graph);
+                    if (!reached[operand.GetInstructionPtr()->GetResId()])
+                    {
+                        reached[operand.GetInstructionPtr()->GetResId()] = true;
+                        worklist.push_back(operand.GetInstructionPtr());
+                    }
+                }
+            }
+        }
+
+        // The remaining operators are computed from constants only and their results are unused. Each is written
+        // in the graph of the operators it depends on, or else in the first graph finalized after it was emplaced.
+        for (const Instruction* instruction : body)
+        {
+            if (graphOf[instruction->GetResId()] != NoGraph)
+            {
+                continue;
+            }
+            for (const Operand& operand : instruction->m_Operands)
+            {
+                if (operand.GetType() == INSTRUCTION_POINTER && isBodyInstruction(operand.GetInstructionPtr()))
+                {
+                    assign(instruction, graphOf[operand.GetInstructionPtr()->GetResId()]);
+                }
+            }
+            if (graphOf[instruction->GetResId()] == NoGraph)
+            {
+                auto home = std::find_if(graphs.begin(), graphs.end(), [&](const GraphDefinition& definition) {
+                    return definition.m_Graph->GetResId() > instruction->GetResId();
+                });
+                if (home == graphs.end())
+                {
+                    home = std::prev(graphs.end());
+                }
+                assign(instruction, static_cast<uint32_t>(std::distance(graphs.begin(), home)));
+            }
+        }
+
+        const auto compositeExtracts = getOrderedInstructionsOfType(OpCompositeExtract);
+        for (uint32_t graph = 0; graph < graphs.size(); ++graph)
+        {
+            const auto& definition = graphs[graph];
+            const auto writeBodyInstruction = [&](const Instruction* inst) {
+                if (graphOf[inst->GetResId()] == graph)
+                {
+                    writeInstruction(inst);
+                }
+            };
+
+            writeInstruction(definition.m_Graph);
+            auto inputs = definition.m_Inputs;
+            sortByKey(inputs, inputIndexKey);
+            std::for_each(inputs.begin(), inputs.end(), writeInstruction);
+            std::for_each(TOSAInstructions.begin(), TOSAInstructions.end(), writeBodyInstruction);
+            std::for_each(compositeExtracts.begin(), compositeExtracts.end(), writeBodyInstruction);
+            auto outputs = definition.m_Outputs;
+            sortByKey(outputs, outputIndexKey);
+            std::for_each(outputs.begin(), outputs.end(), writeInstruction);
+            writeInstruction(definition.m_End);
+        }
+    }
 
     for (const Instruction& ins : spirv)
     {
-        const auto resId = GetResId(ins);
-        if (visitedInstructions.find(resId) == visitedInstructions.end())
+        const auto resId = ins.GetResId();
+        if (reportUnwritten && !visitedInstructions[resId])
         {
             std::cout << "Instruction { OPCODE : " << ins.m_Opcode << " ,RESID : " << resId << " } not written\n";
         }
     }
+    return order;
+}
+
+uint32_t* WriteHeader(const uint32_t bound, uint32_t* binary)
+{
+    *binary++ = MagicNumber;
+    const uint32_t version = (1 << 16) | (GetMinorVersion() << 8);
+    *binary++ = version;
+
+    // Use the ARM vendor ID, which is 5.
+    // This is defined in SPIRV-Headers/include/spirv/spir-v.xml
+    constexpr uint32_t vendor = 5 << 16;
+    *binary++ = vendor;
+
+    *binary++ = bound;
+    // Output the schema (reserved for use and must be 0)
+    *binary++ = 0;
     return binary;
 }
 
-void WriteInstruction(const Instruction& instruction, std::vector<uint32_t>& binary)
+uint32_t* WriteInstruction(const Instruction& instruction, uint32_t* binary, const uint32_t* resIdMap)
 {
     // High 16 bit : Word Count
     // Low 16 bit  : Opcode
     uint32_t word = instruction.GetOpCode();
     word |= instruction.m_WordCount << 16;
-    binary.push_back(word);
+    *binary++ = word;
     for (const Operand& operand : instruction.m_Operands)
     {
-        WriteOperand(operand, binary);
+        binary = WriteOperand(operand, binary, resIdMap);
     }
+    return binary;
 }
 
-void WriteOperand(const Operand& operand, std::vector<uint32_t>& binary)
+uint32_t* WriteOperand(const Operand& operand, uint32_t* binary, const uint32_t* resIdMap)
 {
-    switch (operand.m_Type)
+    switch (operand.GetType())
     {
         case LITERAL_STRING:
         {
-            std::basic_string<char>* str = operand.m_LiteralStr;
-            std::string s = *str;
-
-            const char* data = str->c_str();
-            const size_t numWords = str->size() / 4;
-
-            for (unsigned Idx = 0; Idx < numWords; Idx++)
-            {
-                binary.push_back(*reinterpret_cast<const uint32_t*>(&data[4 * Idx]));
-            }
-
-            const uint32_t remainder = str->size() % 4;
-            uint32_t lastWord = 0;
-            if (remainder)
-            {
-                for (unsigned Idx = 0; Idx < remainder; Idx++)
-                {
-                    // This takes the remaining bytes that don't take up a full word.
-                    // Then combines it using << 8 to place them into an uint32_t.
-                    lastWord |= data[4 * numWords + Idx] << 8 * Idx;
-                }
-            }
-
-            binary.push_back(lastWord);
-            break;
+            const auto& words = operand.GetLiteralString().GetWords();
+            return std::copy(words.begin(), words.end(), binary);
         }
         case RES_ID:
+        {
+            *binary++ = resIdMap ? resIdMap[operand.GetLiteralWord()] : operand.GetLiteralWord();
+            return binary;
+        }
         case LITERAL_WORD:
         {
-            binary.push_back(operand.m_LiteralWord);
-            break;
+            *binary++ = operand.GetLiteralWord();
+            return binary;
         }
         case INSTRUCTION_POINTER:
         {
-            for (const Operand& instructionOperand : operand.m_InstructionPtr->m_Operands)
-            {
-                if (instructionOperand.m_Type == RES_ID)
-                {
-                    WriteOperand(instructionOperand, binary);
-                    break;
-                }
-            }
+            const auto resId = operand.GetInstructionPtr()->GetResId();
+            *binary++ = resIdMap ? resIdMap[resId] : resId;
+            return binary;
         }
         default:
         {
-            break;
+            return binary;
         }
     }
 }
 
-void WriteInstructionsRecursive(const Instruction* instruction,
-                                std::vector<uint32_t>& binary,
-                                std::set<unsigned int>& visitedInstructions)
+void AppendInstructionWithDependencies(const Instruction* instruction,
+                                       EmissionOrder& order,
+                                       VisitedResIds& visitedInstructions,
+                                       std::vector<DependencyFrame>& stack)
 {
-    auto resId = GetResId(*instruction);
-    if (visitedInstructions.find(resId) != visitedInstructions.end())
+    // Depth-first walk with an explicit stack, so long dependency chains cannot overflow the native stack.
+    // Each Instruction is appended after all of its operands, in the same order a recursive walk would produce.
+    if (visitedInstructions[instruction->GetResId()])
     {
         return;
     }
-    visitedInstructions.emplace(resId);
-    for (const Operand& operand : instruction->m_Operands)
+    visitedInstructions[instruction->GetResId()] = true;
+    stack.push_back({instruction, 0});
+    while (!stack.empty())
     {
-        if (operand.m_Type == INSTRUCTION_POINTER)
+        auto& frame = stack.back();
+        const auto& operands = frame.m_Instruction->m_Operands;
+        const Instruction* dependency = nullptr;
+        while (frame.m_NextOperand < operands.size() && dependency == nullptr)
         {
-            WriteInstructionsRecursive(operand.m_InstructionPtr, binary, visitedInstructions);
+            const Operand& operand = operands[frame.m_NextOperand++];
+            if (operand.GetType() == INSTRUCTION_POINTER &&
+                !visitedInstructions[operand.GetInstructionPtr()->GetResId()])
+            {
+                dependency = operand.GetInstructionPtr();
+            }
         }
-    }
-    WriteInstruction(*instruction, binary);
-}
-
-unsigned int GetResId(const Instruction& instruction)
-{
-    for (const auto& operand : instruction.m_Operands)
-    {
-        if (operand.m_Type == RES_ID)
+        if (dependency != nullptr)
         {
-            return operand.m_LiteralWord;
+            visitedInstructions[dependency->GetResId()] = true;
+            // frame is invalidated by the push
+            stack.push_back({dependency, 0});
+            continue;
         }
+        order.push_back(frame.m_Instruction);
+        stack.pop_back();
     }
-    return 0;
 }
 
 constexpr int32_t GetMinorVersion()
@@ -0,0 +1,85 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "TestModules.hpp"
+
+#include <BinarySink.hpp>
+#include <Module.hpp>
+#include <TosaForSpirvCodegen.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sstream>
+
+using namespace tfsc;
+
+TEST(BinarySinkTests, BufferSink)
+{
+    const auto module = BuildLargeModule();
+    const auto expected = WriteToBinary(module);
+
+    ASSERT_EQ(GetBinarySizeInWords(module), expected.size());
+    std::vector<uint32_t> buffer(GetBinarySizeInWords(module));
+    BufferSink sink{buffer.data(), buffer.size()};
+    WriteToBinary(module, sink);
+    EXPECT_EQ(sink.GetWordCount(), expected.size());
+    EXPECT_EQ(buffer, expected);
+
+    std::vector<uint32_t> smallBuffer(expected.size() - 1);
+    BufferSink smallSink{smallBuffer.data(), smallBuffer.size()};
+    EXPECT_THROW(WriteToBinary(module, smallSink), std::runtime_error);
+}
+
+TEST(BinarySinkTests, StreamSink)
+{
+    const auto module = BuildLargeModule();
+    const auto expected = WriteToBinary(module);
+
+    std::ostringstream stream;
+    StreamSink sink{stream};
+    WriteToBinary(module, sink);
+
+    const auto bytes = stream.str();
+    ASSERT_EQ(bytes.size(), expected.size() * sizeof(uint32_t));
+    std::vector<uint32_t> words(expected.size());
+    std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(words.data()));
+    EXPECT_EQ(words, expected);
+}
+
+TEST(BinarySinkTests, FileDescriptorSink)
+{
+    const auto module = BuildLargeModule();
+    const auto expected = WriteToBinary(module);
+
+    FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    FileDescriptorSink sink{fileno(file)};
+    WriteToBinary(module, sink);
+
+    std::vector<uint32_t> words(expected.size() + 1);
+    std::rewind(file);
+    EXPECT_EQ(std::fread(words.data(), sizeof(uint32_t), words.size(), file), expected.size());
+    std::fclose(file);
+    words.resize(expected.size());
+    EXPECT_EQ(words, expected);
+}
+
+TEST(BinarySinkTests, CallbackSink)
+{
+    const auto module = BuildLargeModule();
+    const auto expected = WriteToBinary(module);
+
+    std::vector<uint32_t> words;
+    unsigned int callCount = 0;
+    CallbackSink sink{[&](const uint32_t* chunk, const std::size_t wordCount) {
+        words.insert(words.end(), chunk, chunk + wordCount);
+        ++callCount;
+    }};
+    WriteToBinary(module, sink);
+    EXPECT_EQ(words, expected);
+    // The binary is streamed in chunks rather than materialised in one go
+    EXPECT_GT(callCount, 1u);
+}
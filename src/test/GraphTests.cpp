@@ -69,20 +69,20 @@ TEST(TOSA_FOR_SPIRV_CODEGEN, TestModuleInitialization)
 
 std::vector<int64_t> ExtractShapeFromTensor(const spirv::Instruction* tensorInstruction)
 {
-    const auto tensorShape = tensorInstruction->m_Operands[3].m_InstructionPtr;
+    const auto tensorShape = tensorInstruction->m_Operands[3].GetInstructionPtr();
 
     if (tensorShape->m_Opcode == spv::OpConstantCompositeReplicateEXT)
     {
-        const unsigned int value = tensorShape->m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord;
-        const auto array = tensorShape->m_Operands[0].m_InstructionPtr;
-        const unsigned int size = array->m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord;
+        const unsigned int value = tensorShape->m_Operands[2].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
+        const auto array = tensorShape->m_Operands[0].GetInstructionPtr();
+        const unsigned int size = array->m_Operands[2].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
         return std::vector<int64_t>(size, value);
     }
     std::vector<int64_t> shapeVector;
     for (auto operandIt = std::next(tensorShape->m_Operands.begin(), 2); operandIt != tensorShape->m_Operands.end();
          ++operandIt)
     {
-        shapeVector.push_back(operandIt->m_InstructionPtr->m_Operands[2].m_LiteralWord);
+        shapeVector.push_back(operandIt->GetInstructionPtr()->m_Operands[2].GetLiteralWord());
     }
     return shapeVector;
 }
@@ -122,20 +122,20 @@ TEST(TOSA_FOR_SPIRV_CODEGEN, TestInputOutputOrder)
     constexpr unsigned int inputSize = 5;
     constexpr unsigned int outputSize = 6;
     EXPECT_EQ(graphTypeInstruction.m_Operands.size(), inputSize + outputSize + 2);
-    EXPECT_EQ(graphTypeInstruction.m_Operands[1].m_LiteralWord, inputSize);
+    EXPECT_EQ(graphTypeInstruction.m_Operands[1].GetLiteralWord(), inputSize);
 
     // map the bindings in the module to the opVariables that will be the operands of GraphEntryPoint
     std::unordered_map<const spirv::Instruction*, unsigned int> opVariableToBindingId;
     auto [decorateBegin, decorateEnd] = module->GetInstructionsOfType(spv::OpDecorate);
     for (auto it = decorateBegin; it != decorateEnd; ++it)
     {
-        if (it->m_Operands[1].m_LiteralWord != spv::DecorationBinding)
+        if (it->m_Operands[1].GetLiteralWord() != spv::DecorationBinding)
         {
             continue;
         }
 
-        const auto opVariable = it->m_Operands[0].m_InstructionPtr;
-        opVariableToBindingId.emplace(opVariable, it->m_Operands[2].m_LiteralWord);
+        const auto opVariable = it->m_Operands[0].GetInstructionPtr();
+        opVariableToBindingId.emplace(opVariable, it->m_Operands[2].GetLiteralWord());
     }
 
     // binding ids of entry points should now be in order
@@ -144,7 +144,7 @@ TEST(TOSA_FOR_SPIRV_CODEGEN, TestInputOutputOrder)
          opVariable != entryPointInstruction.m_Operands.end();
          ++opVariable)
     {
-        const unsigned int bindingId = opVariableToBindingId.at(opVariable->m_InstructionPtr);
+        const unsigned int bindingId = opVariableToBindingId.at(opVariable->GetInstructionPtr());
         EXPECT_EQ(bindingId, expectedBindingId++);
     }
 
@@ -155,7 +155,7 @@ TEST(TOSA_FOR_SPIRV_CODEGEN, TestInputOutputOrder)
          tensor != graphTypeInstruction.m_Operands.begin() + inputSize + 2;
          ++tensor)
     {
-        const auto tensorShape = ExtractShapeFromTensor(tensor->m_InstructionPtr);
+        const auto tensorShape = ExtractShapeFromTensor(tensor->GetInstructionPtr());
         EXPECT_EQ(tensorShape[0], expectedShape++);
     }
 
@@ -163,7 +163,7 @@ TEST(TOSA_FOR_SPIRV_CODEGEN, TestInputOutputOrder)
     std::array<unsigned int, 6> expectedOutputShapes = {1, 2, 3, 5, 4, 4};
     for (auto tensor = graphTypeInputEnd; tensor != graphTypeInstruction.m_Operands.end(); ++tensor)
     {
-        const auto tensorShape = ExtractShapeFromTensor(tensor->m_InstructionPtr);
+        const auto tensorShape = ExtractShapeFromTensor(tensor->GetInstructionPtr());
         EXPECT_EQ(tensorShape[0], expectedOutputShapes[index++]);
     }
 }
@@ -182,13 +182,13 @@ TEST(GraphTests, CreateDataType)
     auto bfloat16 = CreateDataType(DataType::bfloat16_t, *sharedModule);
     auto boolType = CreateDataType(DataType::bool_t, *sharedModule);
 
-    CheckDataType(int4.m_InstructionPtr, DataType::int4_t);
-    CheckDataType(int16.m_InstructionPtr, DataType::int16_t);
-    CheckDataType(int32.m_InstructionPtr, DataType::int32_t);
-    CheckDataType(float16.m_InstructionPtr, DataType::float16_t);
-    CheckDataType(float32.m_InstructionPtr, DataType::float32_t);
-    CheckDataType(bfloat16.m_InstructionPtr, DataType::bfloat16_t);
-    CheckDataType(boolType.m_InstructionPtr, DataType::bool_t);
+    CheckDataType(int4.GetInstructionPtr(), DataType::int4_t);
+    CheckDataType(int16.GetInstructionPtr(), DataType::int16_t);
+    CheckDataType(int32.GetInstructionPtr(), DataType::int32_t);
+    CheckDataType(float16.GetInstructionPtr(), DataType::float16_t);
+    CheckDataType(float32.GetInstructionPtr(), DataType::float32_t);
+    CheckDataType(bfloat16.GetInstructionPtr(), DataType::bfloat16_t);
+    CheckDataType(boolType.GetInstructionPtr(), DataType::bool_t);
 }
 
 TEST(GraphTests, CreateConstant)
@@ -204,19 +204,19 @@ TEST(GraphTests, CreateConstant)
     auto float32 = CreateConstant(123, DataType::float32_t, *sharedModule);
     auto bfloat16 = CreateConstant(123, DataType::bfloat16_t, *sharedModule);
 
-    CheckConstant(int4.m_InstructionPtr, DataType::int4_t, 123);
-    CheckConstant(int16.m_InstructionPtr, DataType::int16_t, 123);
-    CheckConstant(int32.m_InstructionPtr, DataType::int32_t, 123);
-    CheckConstant(int48.m_InstructionPtr, DataType::int48_t, 123, 123);
-    CheckConstant(float16.m_InstructionPtr, DataType::float16_t, 123);
-    CheckConstant(float32.m_InstructionPtr, DataType::float32_t, 123);
-    CheckConstant(bfloat16.m_InstructionPtr, DataType::bfloat16_t, 123);
+    CheckConstant(int4.GetInstructionPtr(), DataType::int4_t, 123);
+    CheckConstant(int16.GetInstructionPtr(), DataType::int16_t, 123);
+    CheckConstant(int32.GetInstructionPtr(), DataType::int32_t, 123);
+    CheckConstant(int48.GetInstructionPtr(), DataType::int48_t, 123, 123);
+    CheckConstant(float16.GetInstructionPtr(), DataType::float16_t, 123);
+    CheckConstant(float32.GetInstructionPtr(), DataType::float32_t, 123);
+    CheckConstant(bfloat16.GetInstructionPtr(), DataType::bfloat16_t, 123);
 
     auto boolTrue = CreateConstant(1, DataType::bool_t, *sharedModule);
     auto boolFalse = CreateConstant(0, DataType::bool_t, *sharedModule);
 
-    EXPECT_EQ(boolTrue.m_InstructionPtr->GetOpCode(), OpConstantTrue);
-    EXPECT_EQ(boolFalse.m_InstructionPtr->GetOpCode(), OpConstantFalse);
+    EXPECT_EQ(boolTrue.GetInstructionPtr()->GetOpCode(), OpConstantTrue);
+    EXPECT_EQ(boolFalse.GetInstructionPtr()->GetOpCode(), OpConstantFalse);
 }
 
 TEST(GraphTests, CreateConstantCompositeBasic)
@@ -242,7 +242,7 @@ TEST(GraphTests, CreateConstantCompositeBasic)
         auto typeId = CreateDataType(dt, *sharedModule);
         auto result = CreateConstantComposite(values, typeId, *sharedModule);
 
-        CheckConstantComposite(result.m_InstructionPtr, values, DataType::uint32_t, dt);
+        CheckConstantComposite(result.GetInstructionPtr(), values, DataType::uint32_t, dt);
     }
 }
 
@@ -256,7 +256,7 @@ TEST(GraphTests, CreateCreateConstantCompositeDouble)
     const auto typeId = CreateDataType(DataType::int48_t, *sharedModule);
     const auto result = CreateConstantComposite(values, typeId, *sharedModule, DataType::int48_t);
 
-    CheckConstantComposite(result.m_InstructionPtr, values, DataType::int48_t, DataType::int48_t);
+    CheckConstantComposite(result.GetInstructionPtr(), values, DataType::int48_t, DataType::int48_t);
 }
 
 TEST(GraphTests, CreateConstantCompositeTypedBool)
@@ -272,13 +272,13 @@ TEST(GraphTests, CreateConstantCompositeTypedBool)
 
     const auto result = CreateConstantComposite(boolData, typeId, *sharedModule, tosa::DataType::bool_t);
 
-    ASSERT_EQ(result.m_InstructionPtr->GetOpCode(), spv::OpConstantComposite);
-    ASSERT_EQ(result.m_InstructionPtr->m_Operands.size(), boolData.size() + 2);
+    ASSERT_EQ(result.GetInstructionPtr()->GetOpCode(), spv::OpConstantComposite);
+    ASSERT_EQ(result.GetInstructionPtr()->m_Operands.size(), boolData.size() + 2);
 
     // Verify each element is a bool constant
     for (size_t i = 0; i < boolData.size(); ++i)
     {
-        const auto constant = result.m_InstructionPtr->m_Operands[i + 2].m_InstructionPtr;
+        const auto constant = result.GetInstructionPtr()->m_Operands[i + 2].GetInstructionPtr();
         if (boolData[i] == 1)
         {
             EXPECT_EQ(constant->GetOpCode(), spv::OpConstantTrue) << "Expected OpConstantTrue for index " << i;
@@ -296,23 +296,23 @@ TEST(GraphTests, CreateTensor)
 
     Tensor tensor(DataType::float32_t, {1, 3, 3, 1});
     auto result = CreateTensor(tensor, *sharedModule);
-    CheckTensorType(result.m_InstructionPtr, DataType::float32_t, 4, {1, 3, 3, 1});
+    CheckTensorType(result.GetInstructionPtr(), DataType::float32_t, 4, {1, 3, 3, 1});
 
     Tensor emptyTensor(DataType::float32_t, {});
     auto emptyResult = CreateTensor(emptyTensor, *sharedModule);
-    CheckTensorType(emptyResult.m_InstructionPtr, DataType::float32_t, 1, {});
+    CheckTensorType(emptyResult.GetInstructionPtr(), DataType::float32_t, 1, {});
 
     Tensor int32Tensor(DataType::int32_t, {2, 3, 4, 5});
     result = CreateTensor(int32Tensor, *sharedModule);
-    CheckTensorType(result.m_InstructionPtr, DataType::int32_t, 4, {2, 3, 4, 5});
+    CheckTensorType(result.GetInstructionPtr(), DataType::int32_t, 4, {2, 3, 4, 5});
 
     Tensor int16Tensor(DataType::int16_t, {2, 3, 4, 5});
     result = CreateTensor(int16Tensor, *sharedModule);
-    CheckTensorType(result.m_InstructionPtr, DataType::int16_t, 4, {2, 3, 4, 5});
+    CheckTensorType(result.GetInstructionPtr(), DataType::int16_t, 4, {2, 3, 4, 5});
 
     Tensor int8Tensor(DataType::int8_t, {2, 3, 4, 5});
     result = CreateTensor(int8Tensor, *sharedModule);
-    CheckTensorType(result.m_InstructionPtr, DataType::int8_t, 4, {2, 3, 4, 5});
+    CheckTensorType(result.GetInstructionPtr(), DataType::int8_t, 4, {2, 3, 4, 5});
 }
 
 // Test Graph Constructor
@@ -406,7 +406,7 @@ TEST(GraphTests, CreateAttribute)
     Attribute attribute(data, DataType::uint32_t);
 
     auto result = CreateAttribute(attribute, *sharedModule);
-    CheckConstantComposite(result.m_InstructionPtr, data, DataType::uint32_t, DataType::uint32_t);
+    CheckConstantComposite(result.GetInstructionPtr(), data, DataType::uint32_t, DataType::uint32_t);
 }
 
 TEST(GraphTests, AttributeConversion)
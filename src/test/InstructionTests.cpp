@@ -6,6 +6,9 @@
 #include <Module.hpp>
 #include <gtest/gtest.h>
 
+#include <set>
+#include <thread>
+
 namespace tfsc::spirv
 {
 
@@ -25,11 +28,36 @@ TEST(TOSA_FOR_SPIRV_CODEGEN, Instruction)
 // Test Instruction Constructor
 TEST(InstructionTests, Constructor)
 {
-    Instruction instruction{spv::OpTypeInt, {Operand{1}, Operand{"Test"}}};
+    const LiteralString test{"Test"};
+    Instruction instruction{spv::OpTypeInt, {Operand{1}, Operand{&test}}};
 
     EXPECT_EQ(instruction.GetOpCode(), spv::OpTypeInt);
     EXPECT_EQ(instruction.m_Operands.size(), 2);
-    EXPECT_EQ(instruction.m_WordCount, 1 + Operand(1).WordSize() + Operand("Test").WordSize());
+    EXPECT_EQ(instruction.m_WordCount, 1 + Operand(1).WordSize() + Operand(&test).WordSize());
+}
+
+// Test the cached result id and its position
+TEST(InstructionTests, ResId)
+{
+    Instruction noResId{spv::OpMemoryModel, {Operand{0u}, Operand{1u}}};
+    EXPECT_FALSE(noResId.HasResId());
+    EXPECT_EQ(noResId.GetResId(), 0);
+
+    Instruction constant{spv::OpConstant, {Operand{0u}, Operand{7u, RES_ID}, Operand{1u}}};
+    EXPECT_TRUE(constant.HasResId());
+    EXPECT_EQ(constant.m_ResIdPosition, 1);
+    EXPECT_EQ(constant.GetResId(), 7);
+
+    constant.SetResId(9);
+    EXPECT_EQ(constant.GetResId(), 9);
+    EXPECT_EQ(constant.m_Operands[1], Operand(9u, RES_ID));
+
+    Module module;
+    const auto typeInt = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+    const auto typeFloat = module.EmplaceInstruction(spv::OpTypeFloat, {RESID, Operand{32u}});
+    EXPECT_EQ(typeInt.GetInstructionPtr()->GetResId(), 1);
+    EXPECT_EQ(typeFloat.GetInstructionPtr()->GetResId(), 2);
+    EXPECT_EQ(typeFloat.GetInstructionPtr()->m_Operands[0].GetLiteralWord(), 2);
 }
 
 // Test Comparator - Different Opcodes
@@ -79,7 +107,7 @@ TEST(InstructionTests, CompareInstructionPointers)
     Instruction inst2{spv::OpTypeInt, {instrOp2}};
 
     InstructionComparator comparator;
-    EXPECT_EQ(comparator(inst1, inst2), instrOp1.m_InstructionPtr < instrOp2.m_InstructionPtr);
+    EXPECT_EQ(comparator(inst1, inst2), instrOp1.GetInstructionPtr() < instrOp2.GetInstructionPtr());
 }
 
 // Test InstructionComparator - Equal Instructions
@@ -93,6 +121,62 @@ TEST(InstructionTests, CompareEqualInstructions)
     EXPECT_FALSE(comparator(inst2, inst1));
 }
 
+// Test InstructionHash - ResId values are ignored
+TEST(InstructionTests, HashIgnoresResIdValue)
+{
+    Instruction inst1{spv::OpTypeInt, {Operand{1}, Operand{2, RES_ID}}};
+    Instruction inst2{spv::OpTypeInt, {Operand{1}, Operand{3, RES_ID}}};
+    Instruction inst3{spv::OpTypeInt, {Operand{2}, Operand{3, RES_ID}}};
+
+    InstructionHash hash;
+    InstructionEqual equal;
+    EXPECT_EQ(hash(inst1), hash(inst2));
+    EXPECT_TRUE(equal(inst1, inst2));
+    EXPECT_FALSE(equal(inst1, inst3));
+}
+
+// Test InstructionEqual - Matches the equivalence of InstructionComparator
+TEST(InstructionTests, EqualMatchesComparator)
+{
+    const LiteralString test1{"Test"};
+    const LiteralString test2{"Test"};
+    const LiteralString other{"Other"};
+    Instruction inst1{spv::OpTypeInt, {Operand{1}, Operand{&test1}}};
+    Instruction inst2{spv::OpTypeInt, {Operand{1}, Operand{&test2}}};
+    Instruction inst3{spv::OpTypeInt, {Operand{1}, Operand{&other}}};
+    Instruction inst4{spv::OpTypeFloat, {Operand{1}, Operand{&test1}}};
+
+    InstructionComparator comparator;
+    InstructionEqual equal;
+    EXPECT_EQ(InstructionHash{}(inst1), InstructionHash{}(inst2));
+    EXPECT_TRUE(equal(inst1, inst2));
+    EXPECT_EQ(equal(inst1, inst2), !comparator(inst1, inst2) && !comparator(inst2, inst1));
+    EXPECT_EQ(equal(inst1, inst3), !comparator(inst1, inst3) && !comparator(inst3, inst1));
+    EXPECT_EQ(equal(inst1, inst4), !comparator(inst1, inst4) && !comparator(inst4, inst1));
+}
+
+// Test Instruction hash - Cached on construction and kept valid by SetResId
+TEST(InstructionTests, CachedHash)
+{
+    const std::vector<Operand> operands{Operand{32}, Operand{0, RES_ID}, Operand{1}};
+    Instruction inst{spv::OpTypeInt, operands};
+    const auto hash = InstructionHash{}(spv::OpTypeInt, operands.data(), operands.size());
+    EXPECT_EQ(inst.GetHash(), hash);
+    EXPECT_EQ(InstructionHash{}(inst), hash);
+
+    inst.SetResId(42);
+    EXPECT_EQ(inst.GetHash(), hash);
+
+    Module module;
+    const auto* emplaced = module.EmplaceInstruction(spv::OpTypeInt, operands).GetInstructionPtr();
+    EXPECT_EQ(emplaced->GetHash(), hash);
+    EXPECT_TRUE(InstructionEqual{}(*emplaced, inst));
+
+    // Editing the operands directly leaves the hash stale, which debug builds catch
+    inst.m_Operands[0] = Operand{64};
+    EXPECT_DEBUG_DEATH(inst.GetHash(), "m_Operands was edited");
+}
+
 // Test EmplaceInstruction - Different Instructions
 TEST(ModuleTests, EmplaceUniqueInstruction)
 {
@@ -100,8 +184,8 @@ TEST(ModuleTests, EmplaceUniqueInstruction)
     Operand op1 = module.EmplaceInstruction(spv::OpTypeInt, {Operand{1}});
     Operand op2 = module.EmplaceInstruction(spv::OpTypeFloat, {Operand{1}});
 
-    EXPECT_NE(op1.m_InstructionPtr, nullptr);
-    EXPECT_NE(op2.m_InstructionPtr, nullptr);
+    EXPECT_NE(op1.GetInstructionPtr(), nullptr);
+    EXPECT_NE(op2.GetInstructionPtr(), nullptr);
     EXPECT_NE(op1, op2);
 }
 
@@ -112,7 +196,7 @@ TEST(ModuleTests, EmplaceDuplicateInstruction)
     Operand op1 = module.EmplaceInstruction(spv::OpTypeInt, {Operand{1}});
     Operand op2 = module.EmplaceInstruction(spv::OpTypeInt, {Operand{1}});
 
-    EXPECT_NE(op1.m_InstructionPtr, nullptr);
+    EXPECT_NE(op1.GetInstructionPtr(), nullptr);
     EXPECT_EQ(op1, op2);
 }
 
@@ -125,11 +209,33 @@ TEST(ModuleTests, EmplaceOpVariable)
     Operand op1 = module.EmplaceInstruction(spv::OpVariable, {Operand{1u}});
     Operand op2 = module.EmplaceInstruction(spv::OpVariable, {Operand{1u}});
 
-    EXPECT_NE(op1.m_InstructionPtr, nullptr);
-    EXPECT_NE(op2.m_InstructionPtr, nullptr);
+    EXPECT_NE(op1.GetInstructionPtr(), nullptr);
+    EXPECT_NE(op2.GetInstructionPtr(), nullptr);
     EXPECT_EQ(op1, op2);
 }
 
+// Test EmplaceInstruction - Lookup overloads find the same Instruction
+TEST(ModuleTests, EmplaceInstructionOverloads)
+{
+    Module module;
+
+    const std::vector<Operand> operands{RESID, Operand{32u}, Operand{0u}};
+    const Operand op1 = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+    const Operand op2 = module.EmplaceInstruction(spv::OpTypeInt, operands);
+    const Operand op3 = module.EmplaceInstruction(spv::OpTypeInt, operands.data(), operands.size());
+
+    EXPECT_EQ(op1, op2);
+    EXPECT_EQ(op1, op3);
+    // Operands passed by reference are left untouched
+    EXPECT_EQ(operands.size(), 3);
+    EXPECT_EQ(operands[0].GetLiteralWord(), 0u);
+
+    const Operand op5 = module.EmplaceInstruction(spv::OpTypeInt, operands.data(), 2);
+    EXPECT_NE(op1, op5);
+    EXPECT_EQ(op5.GetInstructionPtr()->m_Operands.size(), 2);
+    EXPECT_EQ(module.GetSpirvGraph().size(), 2);
+}
+
 // Test GetInstructionsOfType - Fetching Instructions
 TEST(ModuleTests, GetInstructionsOfType)
 {
@@ -148,6 +254,536 @@ TEST(ModuleTests, GetInstructionsOfType)
     EXPECT_EQ(count, 2);
 }
 
+// Test GetInstructionsOfType - Interleaved opcodes and missing opcodes
+TEST(ModuleTests, GetInstructionsOfTypeInterleaved)
+{
+    Module module;
+
+    std::vector<Operand> ints;
+    std::vector<Operand> floats;
+    for (uint32_t idx = 0; idx < 10; ++idx)
+    {
+        ints.push_back(module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{idx}, Operand{0u}}));
+        floats.push_back(module.EmplaceInstruction(spv::OpTypeFloat, {RESID, Operand{idx}}));
+    }
+
+    const auto [intsBegin, intsEnd] = module.GetInstructionsOfType(spv::OpTypeInt);
+    ASSERT_EQ(std::distance(intsBegin, intsEnd), 10);
+    auto it = intsBegin;
+    for (const auto& operand : ints)
+    {
+        EXPECT_EQ(&(*it++), operand.GetInstructionPtr());
+    }
+
+    const auto [floatsBegin, floatsEnd] = module.GetInstructionsOfType(spv::OpTypeFloat);
+    ASSERT_EQ(std::distance(floatsBegin, floatsEnd), 10);
+    EXPECT_EQ(&(*floatsBegin), floats.front().GetInstructionPtr());
+
+    const auto [boolsBegin, boolsEnd] = module.GetInstructionsOfType(spv::OpTypeBool);
+    EXPECT_EQ(boolsBegin, boolsEnd);
+}
+
+// Test EraseInstructionsIf - Groups and the deduplication table stay consistent
+TEST(ModuleTests, EraseInstructionsIf)
+{
+    Module module;
+
+    std::vector<Operand> ints;
+    for (uint32_t idx = 0; idx < 4; ++idx)
+    {
+        ints.push_back(module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{idx}, Operand{0u}}));
+    }
+    const auto floatType = module.EmplaceInstruction(spv::OpTypeFloat, {RESID, Operand{32u}});
+    const auto floatResId = floatType.GetInstructionPtr()->GetResId();
+
+    // Remove the first and last Instruction of the OpTypeInt group, and the whole OpTypeFloat group
+    const auto erased = module.EraseInstructionsIf([](const Instruction& instruction) {
+        return instruction.m_Opcode == spv::OpTypeFloat || instruction.m_Operands[1].GetLiteralWord() % 3 == 0;
+    });
+    EXPECT_EQ(erased, 3u);
+    EXPECT_EQ(module.GetSpirvGraph().size(), 2u);
+
+    const auto [intsBegin, intsEnd] = module.GetInstructionsOfType(spv::OpTypeInt);
+    ASSERT_EQ(std::distance(intsBegin, intsEnd), 2);
+    EXPECT_EQ(&(*intsBegin), ints[1].GetInstructionPtr());
+    EXPECT_EQ(&(*std::next(intsBegin)), ints[2].GetInstructionPtr());
+    const auto [floatsBegin, floatsEnd] = module.GetInstructionsOfType(spv::OpTypeFloat);
+    EXPECT_EQ(floatsBegin, floatsEnd);
+
+    // Kept Instructions are still found, removed ones are created anew with a fresh ResId
+    EXPECT_EQ(module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{1u}, Operand{0u}}), ints[1]);
+    const auto recreated = module.EmplaceInstruction(spv::OpTypeFloat, {RESID, Operand{32u}});
+    EXPECT_EQ(recreated.GetInstructionPtr()->GetResId(), floatResId + 1);
+    const auto [groupBegin, groupEnd] = module.GetInstructionsOfType(spv::OpTypeFloat);
+    EXPECT_EQ(std::distance(groupBegin, groupEnd), 1);
+}
+
+// Test EmplaceInstructions - A batch matches emplacing each Instruction in turn
+TEST(ModuleTests, EmplaceInstructions)
+{
+    Module batched;
+    Module sequential;
+    const auto batchedType = batched.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+    const auto sequentialType = sequential.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+
+    const std::vector<uint32_t> values{3, 1, 3, 2, 1};
+    std::vector<Operand> operands;
+    for (const auto value : values)
+    {
+        operands.insert(operands.end(), {batchedType, RESID, Operand{value}});
+    }
+    std::vector<InstructionDescriptor> descriptors;
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        descriptors.push_back({spv::OpConstant, operands.data() + idx * 3, 3});
+    }
+    // An Instruction already in the Module is matched too
+    const Operand intTypeOperands[] = {RESID, Operand{32u}, Operand{0u}};
+    descriptors.push_back({spv::OpTypeInt, intTypeOperands, 3});
+
+    const auto results = batched.EmplaceInstructions(descriptors);
+    ASSERT_EQ(results.size(), descriptors.size());
+    EXPECT_EQ(results[0], results[2]);
+    EXPECT_EQ(results[1], results[4]);
+    EXPECT_EQ(results[5], batchedType);
+
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        const auto expected =
+            sequential.EmplaceInstruction(spv::OpConstant, {sequentialType, RESID, Operand{values[idx]}});
+        EXPECT_EQ(results[idx].GetInstructionPtr()->GetResId(), expected.GetInstructionPtr()->GetResId());
+    }
+    EXPECT_EQ(batched.GetSpirvGraph().size(), sequential.GetSpirvGraph().size());
+    EXPECT_EQ(batched.GetResIdBound(), sequential.GetResIdBound());
+}
+
+// Test EmplaceInstructions - Batches emplaced concurrently store each Instruction once
+TEST(ModuleTests, ConcurrentBatchEmplacement)
+{
+    ModuleOptions options;
+    options.m_Concurrent = true;
+    options.m_UseArena = true;
+    options.m_ShardCount = 8;
+    Module module{options};
+
+    constexpr unsigned int threadCount = 4;
+    constexpr uint32_t typeCount = 300;
+    std::vector<Operand> operands;
+    for (uint32_t width = 0; width < typeCount; ++width)
+    {
+        operands.insert(operands.end(), {RESID, Operand{width}, Operand{0u}});
+    }
+    std::vector<std::vector<Operand>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (unsigned int thread = 0; thread < threadCount; ++thread)
+    {
+        threads.emplace_back([&, thread]() {
+            // Each thread walks the types in a different order
+            std::vector<InstructionDescriptor> descriptors;
+            for (uint32_t idx = 0; idx < typeCount; ++idx)
+            {
+                const auto width = (idx * 7 + thread * 31) % typeCount;
+                descriptors.push_back({spv::OpTypeInt, operands.data() + width * 3, 3});
+            }
+            const auto batch = module.EmplaceInstructions(descriptors);
+            results[thread].resize(typeCount);
+            for (uint32_t idx = 0; idx < typeCount; ++idx)
+            {
+                results[thread][descriptors[idx].m_Operands[1].GetLiteralWord()] = batch[idx];
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (unsigned int thread = 1; thread < threadCount; ++thread)
+    {
+        EXPECT_EQ(results[thread], results[0]);
+    }
+    EXPECT_EQ(module.GetSpirvGraph().size(), typeCount);
+    EXPECT_EQ(module.GetResIdBound(), typeCount + 1);
+    for (uint32_t width = 0; width < typeCount; ++width)
+    {
+        EXPECT_EQ(results[0][width].GetInstructionPtr()->m_Operands[1].GetLiteralWord(), width);
+    }
+}
+
+// Test GetUsers - Reverse use-def index maintained on emplacement and erasure
+TEST(ModuleTests, TrackUses)
+{
+    EXPECT_THROW(Module{}.GetUsers(Instruction{spv::OpTypeBool, {RESID}}), std::runtime_error);
+
+    for (const bool useArena : {false, true})
+    {
+        ModuleOptions options;
+        options.m_TrackUses = true;
+        options.m_UseArena = useArena;
+        Module module{options};
+        ASSERT_TRUE(module.TracksUses());
+
+        const auto intType = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+        const auto one = module.EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{1u}});
+        const auto two = module.EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{2u}});
+        // A user of the same definition through several Operands is listed once, and duplicates add no users
+        const auto pair = module.EmplaceInstruction(spv::OpConstantComposite, {intType, RESID, one, one});
+        module.EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{1u}});
+
+        const auto& intUsers = module.GetUsers(*intType.GetInstructionPtr());
+        ASSERT_EQ(intUsers.size(), 3u);
+        EXPECT_EQ(intUsers[0], one.GetInstructionPtr());
+        EXPECT_EQ(intUsers[1], two.GetInstructionPtr());
+        EXPECT_EQ(intUsers[2], pair.GetInstructionPtr());
+        ASSERT_EQ(module.GetUsers(*one.GetInstructionPtr()).size(), 1u);
+        EXPECT_EQ(module.GetUsers(*one.GetInstructionPtr()).front(), pair.GetInstructionPtr());
+        EXPECT_TRUE(module.GetUsers(*two.GetInstructionPtr()).empty());
+        EXPECT_TRUE(module.GetUsers(*pair.GetInstructionPtr()).empty());
+
+        // Erased users are removed from the lists of their definitions
+        module.EraseInstructionsIf([](const Instruction& instruction) {
+            return instruction.m_Opcode == spv::OpConstantComposite;
+        });
+        EXPECT_TRUE(module.GetUsers(*one.GetInstructionPtr()).empty());
+        EXPECT_EQ(module.GetUsers(*intType.GetInstructionPtr()).size(), 2u);
+    }
+}
+
+// Test EmplaceInstruction - Deduplication and stable addresses across many Instructions
+TEST(ModuleTests, EmplaceManyInstructions)
+{
+    Module module;
+
+    const Operand first = module.EmplaceInstruction(spv::OpConstant, {Operand{0u}, RESID, Operand{0u}});
+    std::vector<Operand> constants{first};
+    for (uint32_t idx = 1; idx < 1000; ++idx)
+    {
+        module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{idx % 7}, Operand{0u}});
+        constants.push_back(module.EmplaceInstruction(spv::OpConstant, {Operand{0u}, RESID, Operand{idx}}));
+    }
+
+    for (uint32_t idx = 0; idx < 1000; ++idx)
+    {
+        EXPECT_EQ(module.EmplaceInstruction(spv::OpConstant, {Operand{0u}, RESID, Operand{idx}}), constants[idx]);
+    }
+    EXPECT_EQ(first.GetInstructionPtr()->m_Operands[2].GetLiteralWord(), 0u);
+
+    // Instructions of the same opcode are adjacent and kept in emplacement order
+    const auto [constantsBegin, constantsEnd] = module.GetInstructionsOfType(spv::OpConstant);
+    EXPECT_EQ(std::distance(constantsBegin, constantsEnd), 1000);
+    EXPECT_EQ(&(*constantsBegin), first.GetInstructionPtr());
+    const auto [intsBegin, intsEnd] = module.GetInstructionsOfType(spv::OpTypeInt);
+    EXPECT_EQ(std::distance(intsBegin, intsEnd), 7);
+    EXPECT_EQ(module.GetSpirvGraph().size(), 1007);
+}
+
+// Test Module arena mode - Instructions match those of a default Module
+TEST(ModuleTests, ArenaModule)
+{
+    ModuleOptions options;
+    options.m_UseArena = true;
+    options.m_ArenaChunkSize = 256;
+    Module arenaModule{options};
+    Module defaultModule;
+
+    for (Module* module : {&arenaModule, &defaultModule})
+    {
+        module->EmplaceInstruction(spv::OpExtInstImport, {RESID, module->EmplaceString("TOSA.001000.1")});
+        for (uint32_t idx = 0; idx < 100; ++idx)
+        {
+            const auto type = module->EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{idx % 3}, Operand{0u}});
+            module->EmplaceInstruction(spv::OpConstant, {type, RESID, Operand{idx % 10}});
+            module->EmplaceInstructionNonUnique(spv::OpVariable, {type, RESID, Operand{0u}});
+        }
+    }
+
+    const auto& arenaGraph = arenaModule.GetSpirvGraph();
+    const auto& defaultGraph = defaultModule.GetSpirvGraph();
+    ASSERT_EQ(arenaGraph.size(), defaultGraph.size());
+    EXPECT_EQ(arenaGraph.size(), 1 + 3 + 30 + 100);
+    auto defaultIt = defaultGraph.begin();
+    for (const auto& instruction : arenaGraph)
+    {
+        EXPECT_EQ(instruction.m_Opcode, defaultIt->m_Opcode);
+        EXPECT_EQ(instruction.m_WordCount, defaultIt->m_WordCount);
+        EXPECT_EQ(instruction.m_Operands.size(), defaultIt->m_Operands.size());
+        ++defaultIt;
+    }
+
+    // Copies of arena Instructions do not refer to the arena
+    const Instruction copy = arenaGraph.front();
+    EXPECT_EQ(copy.m_Operands.get_allocator().resource(), std::pmr::get_default_resource());
+
+    // Strings of an arena Module and their encodings are allocated from the arena
+    const auto& string = arenaModule.EmplaceString("a string too long for the small string buffer").GetLiteralString();
+    EXPECT_NE(string.GetString().get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(string.GetWords().get_allocator().resource(), string.GetString().get_allocator().resource());
+}
+
+// Test Fork - Forks share the Instructions and strings of their parent, and add their own separately
+TEST(ModuleTests, Fork)
+{
+    for (const bool useArena : {false, true})
+    {
+        ModuleOptions options;
+        options.m_UseArena = useArena;
+        auto parent = std::make_shared<Module>(options);
+        const auto intType = parent->EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+        const auto one = parent->EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{1u}});
+        const auto name = parent->EmplaceString("shared");
+
+        const auto fork = parent->Fork();
+        EXPECT_EQ(fork->GetResIdBound(), parent->GetResIdBound());
+        // Instructions and strings of the parent are found rather than copied
+        EXPECT_EQ(fork->EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{1u}}), one);
+        EXPECT_EQ(fork->EmplaceString("shared"), name);
+        const Operand operands[] = {intType, RESID, Operand{1u}};
+        const auto results = fork->EmplaceInstructions({{spv::OpConstant, operands, 3}});
+        EXPECT_EQ(results, std::vector{one});
+
+        // The Instructions each Module adds are only visible to it, and get the same ResIds
+        const auto forkTwo = fork->EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{2u}});
+        const auto parentThree = parent->EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{3u}});
+        EXPECT_EQ(forkTwo.GetInstructionPtr()->GetResId(), parentThree.GetInstructionPtr()->GetResId());
+        EXPECT_EQ(fork->GetSpirvGraph().size(), 3u);
+        EXPECT_EQ(parent->GetSpirvGraph().size(), 3u);
+
+        // Iteration visits the shared Instructions before the own ones
+        const auto [first, last] = fork->GetInstructionsOfType(spv::OpConstant);
+        std::vector<const Instruction*> constants;
+        for (auto it = first; it != last; ++it)
+        {
+            constants.push_back(&(*it));
+        }
+        EXPECT_EQ(constants, (std::vector{one.GetInstructionPtr(), forkTwo.GetInstructionPtr()}));
+        EXPECT_EQ(&fork->GetSpirvGraph().front(), intType.GetInstructionPtr());
+
+        // Only the own Instructions of a fork can be erased
+        const auto isConstant = [](const Instruction& instruction) { return instruction.m_Opcode == spv::OpConstant; };
+        EXPECT_EQ(fork->EraseInstructionsIf(isConstant), 1u);
+        EXPECT_EQ(fork->GetSpirvGraph().size(), 2u);
+
+        // A fork of a fork shares the layers of both, and outlives them along with their arenas
+        const auto own = fork->EmplaceString("own");
+        const auto grandchild = fork->Fork();
+        fork->EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{4u}});
+        parent.reset();
+        EXPECT_EQ(grandchild->EmplaceString("own"), own);
+        EXPECT_EQ(grandchild->EmplaceString("shared").GetLiteralString().GetString(), "shared");
+        EXPECT_EQ(grandchild->GetSpirvGraph().size(), 2u);
+        const auto five = grandchild->EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{5u}});
+        EXPECT_EQ(grandchild->GetSpirvGraph().size(), 3u);
+        const auto grandchildConstants = grandchild->GetInstructionsOfType(spv::OpConstant).first;
+        EXPECT_EQ(&(*grandchildConstants), one.GetInstructionPtr());
+        EXPECT_EQ(&(*std::next(grandchildConstants)), five.GetInstructionPtr());
+    }
+}
+
+// Test Fork - The users of shared Instructions are copied on write
+TEST(ModuleTests, ForkTrackUses)
+{
+    ModuleOptions options;
+    options.m_TrackUses = true;
+    Module parent{options};
+    const auto intType = parent.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+    const auto one = parent.EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{1u}});
+
+    const auto fork = parent.Fork();
+    const auto two = fork->EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{2u}});
+    ASSERT_EQ(fork->GetUsers(*intType.GetInstructionPtr()).size(), 2u);
+    EXPECT_EQ(fork->GetUsers(*intType.GetInstructionPtr())[0], one.GetInstructionPtr());
+    EXPECT_EQ(fork->GetUsers(*intType.GetInstructionPtr())[1], two.GetInstructionPtr());
+    EXPECT_EQ(parent.GetUsers(*intType.GetInstructionPtr()).size(), 1u);
+    EXPECT_TRUE(fork->GetUsers(*one.GetInstructionPtr()).empty());
+
+    // Erasing a user of a shared Instruction only updates the users seen by the fork
+    fork->EraseInstructionsIf([&](const Instruction& instruction) { return &instruction == two.GetInstructionPtr(); });
+    EXPECT_EQ(fork->GetUsers(*intType.GetInstructionPtr()).size(), 1u);
+    parent.EmplaceInstruction(spv::OpConstant, {intType, RESID, Operand{3u}});
+    EXPECT_EQ(parent.GetUsers(*intType.GetInstructionPtr()).size(), 2u);
+    EXPECT_EQ(fork->GetUsers(*intType.GetInstructionPtr()).size(), 1u);
+}
+
+// Test Reserve - Pre-sizing only affects the storage of the Module, not its Instructions
+TEST(ModuleTests, Reserve)
+{
+    for (const bool useArena : {false, true})
+    {
+        ModuleOptions options;
+        options.m_UseArena = useArena;
+        options.m_ArenaChunkSize = 256;
+        options.m_TrackUses = true;
+        Module reserved{options};
+        Module unreserved{options};
+        // Reserve less than is emplaced, so an arena Module also grows past its reserved chunk
+        reserved.Reserve(50, 150, 1);
+
+        for (Module* module : {&reserved, &unreserved})
+        {
+            module->EmplaceInstruction(spv::OpExtInstImport, {RESID, module->EmplaceString("TOSA.001000.1")});
+            for (uint32_t idx = 0; idx < 100; ++idx)
+            {
+                const auto type = module->EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{idx % 3}, Operand{0u}});
+                module->EmplaceInstruction(spv::OpConstant, {type, RESID, Operand{idx}});
+            }
+        }
+
+        ASSERT_EQ(reserved.GetSpirvGraph().size(), unreserved.GetSpirvGraph().size());
+        auto unreservedIt = unreserved.GetSpirvGraph().begin();
+        for (const auto& instruction : reserved.GetSpirvGraph())
+        {
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&instruction) % alignof(Instruction), 0u);
+            EXPECT_EQ(instruction.m_Opcode, unreservedIt->m_Opcode);
+            EXPECT_EQ(instruction.m_WordCount, unreservedIt->m_WordCount);
+            EXPECT_EQ(instruction.GetResId(), unreservedIt->GetResId());
+            EXPECT_EQ(reserved.GetUsers(instruction).size(), unreserved.GetUsers(*unreservedIt).size());
+            ++unreservedIt;
+        }
+    }
+}
+
+TEST(ModuleTests, TypeCache)
+{
+    ModuleOptions options;
+    options.m_TypeCacheSize = 3;
+    Module module{options};
+    const auto int32 = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+    const auto int8 = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{8u}, Operand{0u}});
+    const std::vector<uint32_t> shape{1, 16, 16, 8};
+
+    EXPECT_EQ(module.FindCachedType(1, shape.data(), shape.size()), nullptr);
+    module.CacheType(1, shape.data(), shape.size(), int32.GetInstructionPtr());
+    EXPECT_EQ(module.FindCachedType(1, shape.data(), shape.size()), int32.GetInstructionPtr());
+    // The tag and every word are part of the key
+    EXPECT_EQ(module.FindCachedType(2, shape.data(), shape.size()), nullptr);
+    EXPECT_EQ(module.FindCachedType(1, shape.data(), shape.size() - 1), nullptr);
+
+    auto stats = module.GetTypeCacheStats();
+    EXPECT_EQ(stats.m_Hits, 1u);
+    EXPECT_EQ(stats.m_Misses, 3u);
+    EXPECT_DOUBLE_EQ(stats.GetHitRate(), 0.25);
+
+    // A key replaces the previous occupant of its slot, 4 slots cannot hold 5 keys
+    for (uint32_t tag = 0; tag < 5; ++tag)
+    {
+        module.CacheType(tag, nullptr, 0, int8.GetInstructionPtr());
+    }
+    unsigned int hits = 0;
+    for (uint32_t tag = 0; tag < 5; ++tag)
+    {
+        hits += module.FindCachedType(tag, nullptr, 0) == int8.GetInstructionPtr();
+    }
+    EXPECT_GT(hits, 0u);
+    EXPECT_LT(hits, 5u);
+
+    // Keys longer than a slot can hold are never cached
+    const std::vector<uint32_t> longKey(Module::TypeCacheKeyWords + 1, 1);
+    module.CacheType(1, longKey.data(), longKey.size(), int32.GetInstructionPtr());
+    EXPECT_EQ(module.FindCachedType(1, longKey.data(), longKey.size()), nullptr);
+
+    // Erasing Instructions empties the cache, which may refer to them
+    module.CacheType(1, shape.data(), shape.size(), int32.GetInstructionPtr());
+    module.EraseInstructionsIf([&](const Instruction& inst) { return &inst == int8.GetInstructionPtr(); });
+    EXPECT_EQ(module.FindCachedType(1, shape.data(), shape.size()), nullptr);
+
+    // A disabled cache never hits
+    options.m_TypeCacheSize = 0;
+    Module uncached{options};
+    uncached.CacheType(1, shape.data(), shape.size(), int32.GetInstructionPtr());
+    EXPECT_EQ(uncached.FindCachedType(1, shape.data(), shape.size()), nullptr);
+}
+
+TEST(ModuleTests, ConstantPool)
+{
+    Module module;
+    const auto int32 = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+    std::vector<const Instruction*> constants;
+    for (uint32_t value = 0; value < 2000; ++value)
+    {
+        const auto constant = module.EmplaceInstruction(spv::OpConstant, {int32, RESID, Operand{value * 7}});
+        constants.push_back(constant.GetInstructionPtr());
+        EXPECT_EQ(module.FindPooledConstant(3, value * 7), nullptr);
+        module.PoolConstant(3, value * 7, constant.GetInstructionPtr());
+    }
+    // Small values take the direct path, large ones the hash table, which grew past its initial size
+    for (uint32_t value = 0; value < 2000; ++value)
+    {
+        EXPECT_EQ(module.FindPooledConstant(3, value * 7), constants[value]);
+    }
+    EXPECT_EQ(module.FindPooledConstant(4, 7), nullptr);
+    EXPECT_EQ(module.FindPooledConstant(4, 7000), nullptr);
+    EXPECT_EQ(module.FindPooledConstant(Module::SmallConstantTagCount, 7), nullptr);
+
+    // A constant pooled again under the same key replaces the previous one
+    module.PoolConstant(3, 7000, constants[0]);
+    EXPECT_EQ(module.FindPooledConstant(3, 7000), constants[0]);
+
+    // Erasing Instructions empties the pool, which may refer to them
+    module.EraseInstructionsIf([&](const Instruction& inst) { return &inst == constants[1]; });
+    EXPECT_EQ(module.FindPooledConstant(3, 0), nullptr);
+    EXPECT_EQ(module.FindPooledConstant(3, 7000), nullptr);
+}
+
+TEST(ModuleTests, ConcurrentEmplacement)
+{
+    ModuleOptions options;
+    options.m_Concurrent = true;
+    options.m_UseArena = true;
+    options.m_TrackUses = true;
+    options.m_ShardCount = 6;
+    Module module{options};
+
+    // Every thread emplaces the same Instructions and strings, each of which must be stored once
+    constexpr unsigned int threadCount = 4;
+    constexpr unsigned int typeCount = 200;
+    std::vector<std::vector<Operand>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (unsigned int thread = 0; thread < threadCount; ++thread)
+    {
+        threads.emplace_back([&module, &results, thread]() {
+            for (unsigned int width = 0; width < typeCount; ++width)
+            {
+                const auto type = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{width}, Operand{0u}});
+                module.EmplaceInstruction(spv::OpConstant, {type, RESID, Operand{width}});
+                module.EmplaceInstruction(spv::OpName, {type, module.EmplaceString(std::to_string(width))});
+                results[thread].push_back(type);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (unsigned int thread = 1; thread < threadCount; ++thread)
+    {
+        EXPECT_EQ(results[thread], results[0]);
+    }
+
+    const auto [typeBegin, typeEnd] = module.GetInstructionsOfType(spv::OpTypeInt);
+    const auto [constantBegin, constantEnd] = module.GetInstructionsOfType(spv::OpConstant);
+    EXPECT_EQ(std::distance(typeBegin, typeEnd), typeCount);
+    EXPECT_EQ(std::distance(constantBegin, constantEnd), typeCount);
+    EXPECT_EQ(module.GetSpirvGraph().size(), 3 * typeCount);
+
+    // ResIds are unique and below the bound, though their order depends on the interleaving of the threads
+    std::set<uint32_t> resIds;
+    for (const auto& instruction : module.GetSpirvGraph())
+    {
+        if (instruction.HasResId())
+        {
+            EXPECT_LT(instruction.GetResId(), module.GetResIdBound());
+            resIds.insert(instruction.GetResId());
+        }
+    }
+    EXPECT_EQ(resIds.size(), 2 * typeCount);
+
+    for (const auto& type : results[0])
+    {
+        EXPECT_EQ(module.GetUsers(*type.GetInstructionPtr()).size(), 2u);
+    }
+}
+
 // Test EmplaceInstructionNonUnique - Instructions are Always Unique
 TEST(ModuleTests, EmplaceInstructionNonUniqueCreatesUniqueInstructions)
 {
@@ -157,21 +793,21 @@ TEST(ModuleTests, EmplaceInstructionNonUniqueCreatesUniqueInstructions)
     Operand op2 = module.EmplaceInstructionNonUnique(spv::OpTypeInt, {Operand{1}, RESID});
 
     // Both instructions should have unique pointers
-    EXPECT_NE(op1.m_InstructionPtr, nullptr);
-    EXPECT_NE(op2.m_InstructionPtr, nullptr);
+    EXPECT_NE(op1.GetInstructionPtr(), nullptr);
+    EXPECT_NE(op2.GetInstructionPtr(), nullptr);
     EXPECT_NE(op1, op2);
 
-    auto& inst1Operands = op1.m_InstructionPtr->m_Operands;
-    auto& inst2Operands = op2.m_InstructionPtr->m_Operands;
+    auto& inst1Operands = op1.GetInstructionPtr()->m_Operands;
+    auto& inst2Operands = op2.GetInstructionPtr()->m_Operands;
 
     EXPECT_EQ(inst1Operands.size(), inst2Operands.size());
     bool hasDifferentResId = false;
 
     for (size_t i = 0; i < inst1Operands.size(); ++i)
     {
-        if (inst1Operands[i].m_Type == RES_ID && inst2Operands[i].m_Type == RES_ID)
+        if (inst1Operands[i].GetType() == RES_ID && inst2Operands[i].GetType() == RES_ID)
         {
-            if (inst1Operands[i].m_LiteralWord != inst2Operands[i].m_LiteralWord)
+            if (inst1Operands[i].GetLiteralWord() != inst2Operands[i].GetLiteralWord())
             {
                 hasDifferentResId = true;
                 break;
@@ -4,35 +4,48 @@
 //
 
 #include <Instruction.hpp>
+#include <Module.hpp>
 
 #include <gtest/gtest.h>
 
+#include <type_traits>
+
 using namespace tfsc::spirv;
 
+static_assert(sizeof(Operand) == 8, "Operand must fit in a single 64-bit word");
+static_assert(std::is_trivially_copyable_v<Operand>, "Operand must be trivially copyable");
+
 // Test Operand Type and Word Size
 TEST(OperandTests, TypeAndWordSize)
 {
     Operand intOperand(1234);
-    EXPECT_EQ(intOperand.m_Type, LITERAL_WORD);
+    EXPECT_EQ(intOperand.GetType(), LITERAL_WORD);
     EXPECT_EQ(intOperand.WordSize(), 1);
 
     Operand residOperand(1234, RES_ID);
-    EXPECT_EQ(residOperand.m_Type, RES_ID);
+    EXPECT_EQ(residOperand.GetType(), RES_ID);
 
-    Operand strOperand("Test");
-    EXPECT_EQ(strOperand.m_Type, LITERAL_STRING);
+    const LiteralString test{"Test"}, empty{""}, longer{"LongerString"};
+    Operand strOperand(&test);
+    EXPECT_EQ(strOperand.GetType(), LITERAL_STRING);
+    EXPECT_EQ(strOperand.GetLiteralStr(), "Test");
     EXPECT_EQ(strOperand.WordSize(), 2); // "Test" (4 chars + 1 null)
 
-    Operand emptyStrOperand("");
+    Operand emptyStrOperand(&empty);
     EXPECT_EQ(emptyStrOperand.WordSize(), 1); // "" (1 null char)
 
-    Operand longStrOperand("LongerString");
+    Operand longStrOperand(&longer);
     EXPECT_EQ(longStrOperand.WordSize(), 4); // "LongerString" (13 chars + 1 null)
 
     Instruction instruction{spv::OpTypeGraphARM, {Operand{0u}, Operand{0u}}};
     Operand instrOperand(&instruction);
-    EXPECT_EQ(instrOperand.m_Type, INSTRUCTION_POINTER);
-    EXPECT_EQ(Operand().m_Type, UNINITIALIZED);
+    EXPECT_EQ(instrOperand.GetType(), INSTRUCTION_POINTER);
+    EXPECT_EQ(instrOperand.GetInstructionPtr(), &instruction);
+    EXPECT_EQ(Operand().GetType(), UNINITIALIZED);
+
+    Operand maxOperand(0xFFFFFFFFu, RES_ID);
+    EXPECT_EQ(maxOperand.GetType(), RES_ID);
+    EXPECT_EQ(maxOperand.GetLiteralWord(), 0xFFFFFFFFu);
 }
 
 // Test Equality, Inequality, and Less Than Operators
@@ -48,7 +61,8 @@ TEST(OperandTests, Operators)
     EXPECT_NE(resOperand1, resOperand3);
     EXPECT_LT(resOperand1, resOperand3);
 
-    Operand strOperand1("Equal"), strOperand2("Equal"), strOperand3("NotEqual");
+    const LiteralString equal1{"Equal"}, equal2{"Equal"}, notEqual{"NotEqual"};
+    Operand strOperand1(&equal1), strOperand2(&equal2), strOperand3(&notEqual);
     EXPECT_EQ(strOperand1, strOperand2);
     EXPECT_NE(strOperand1, strOperand3);
     EXPECT_NE(strOperand1, strOperand3);
@@ -81,10 +95,12 @@ TEST(OperandTests, CopyBehavior)
     Operand copyIns(insOriginal);
     EXPECT_EQ(insOriginal, copyIns);
 
-    Operand strOriginal("Test");
+    // Copies of a string Operand share the payload
+    const LiteralString test{"Test"};
+    Operand strOriginal(&test);
     Operand copyStr(strOriginal);
-    EXPECT_EQ(*copyStr.m_LiteralStr, "Test");
-    EXPECT_NE(strOriginal.m_LiteralStr, copyStr.m_LiteralStr);
+    EXPECT_EQ(copyStr.GetLiteralStr(), "Test");
+    EXPECT_EQ(&strOriginal.GetLiteralStr(), &copyStr.GetLiteralStr());
 
     // Test Copy Assignment
     Operand intA(42);
@@ -99,69 +115,91 @@ TEST(OperandTests, CopyBehavior)
     Operand insB = insA;
     EXPECT_EQ(insA, insB);
 
-    Operand strA("Copy");
+    const LiteralString copy{"Copy"};
+    Operand strA(&copy);
     Operand strB = strA;
-    EXPECT_EQ(*strA.m_LiteralStr, *strB.m_LiteralStr);
-    EXPECT_NE(strA.m_LiteralStr, strB.m_LiteralStr);
+    EXPECT_EQ(strA, strB);
+    EXPECT_EQ(&strA.GetLiteralStr(), &strB.GetLiteralStr());
 
     // Test Self Assignment
-    Operand selfAssign("SelfTest");
+    const LiteralString selfTest{"SelfTest"};
+    Operand selfAssign(&selfTest);
     selfAssign = selfAssign;
-    EXPECT_EQ(*selfAssign.m_LiteralStr, "SelfTest");
+    EXPECT_EQ(selfAssign.GetLiteralStr(), "SelfTest");
 }
 
 // Test Move Constructor & Move Assignment
 TEST(OperandTests, MoveBehavior)
 {
+    // Operands are trivially copyable, so moving leaves the source unchanged
     Operand intOriginal(123);
     Operand movedInt(std::move(intOriginal));
-    EXPECT_EQ(movedInt.m_LiteralWord, 123);
-    // Defaults to 0 after move
-    EXPECT_EQ(intOriginal.m_LiteralWord, 0);
+    EXPECT_EQ(movedInt.GetLiteralWord(), 123);
+    EXPECT_EQ(intOriginal.GetLiteralWord(), 123);
 
     Operand resOriginal(123, RES_ID);
     Operand movedRes(std::move(resOriginal));
-    EXPECT_EQ(movedRes.m_LiteralWord, 123);
-    EXPECT_EQ(resOriginal.m_LiteralWord, 0);
+    EXPECT_EQ(movedRes.GetLiteralWord(), 123);
+    EXPECT_EQ(movedRes.GetType(), RES_ID);
 
-    Operand strOriginal("MoveTest");
+    const LiteralString moveTest{"MoveTest"};
+    Operand strOriginal(&moveTest);
     Operand movedStr(std::move(strOriginal));
-    EXPECT_EQ(*movedStr.m_LiteralStr, "MoveTest");
-    EXPECT_EQ(strOriginal.m_LiteralStr, nullptr);
+    EXPECT_EQ(movedStr.GetLiteralStr(), "MoveTest");
 
     Instruction instruction{spv::OpTypeGraphARM, {Operand{0u}, Operand{0u}}};
     Operand insOriginal(&instruction);
     Operand movedIns(std::move(insOriginal));
-    EXPECT_EQ(movedIns.m_InstructionPtr, &instruction);
-    EXPECT_EQ(insOriginal.m_InstructionPtr, nullptr);
+    EXPECT_EQ(movedIns.GetInstructionPtr(), &instruction);
 
     // Move Assignment
-    Operand strOperand1("Move1"), strOperand2("Move2");
+    const LiteralString move1{"Move1"}, move2{"Move2"};
+    Operand strOperand1(&move1), strOperand2(&move2);
     strOperand2 = std::move(strOperand1);
-    EXPECT_EQ(*strOperand2.m_LiteralStr, "Move1");
-    EXPECT_EQ(strOperand1.m_LiteralStr, nullptr);
+    EXPECT_EQ(strOperand2.GetLiteralStr(), "Move1");
 
     Operand intOperand1(100), intOperand2(200);
     intOperand2 = std::move(intOperand1);
-    EXPECT_EQ(intOperand2.m_LiteralWord, 100);
-    EXPECT_EQ(intOperand1.m_LiteralWord, 0);
+    EXPECT_EQ(intOperand2.GetLiteralWord(), 100);
 
-    Operand insOperand1(&instruction), insOperand2("Move2");
+    Operand insOperand1(&instruction), insOperand2(&move2);
     insOperand2 = std::move(insOperand1);
-    EXPECT_EQ(insOperand2.m_InstructionPtr, &instruction);
-    EXPECT_EQ(insOperand1.m_InstructionPtr, nullptr);
+    EXPECT_EQ(insOperand2.GetType(), INSTRUCTION_POINTER);
+    EXPECT_EQ(insOperand2.GetInstructionPtr(), &instruction);
+}
+
+TEST(OperandTests, ModuleOwnsStrings)
+{
+    Module module;
+    Operand str = module.EmplaceString("Owned");
+    EXPECT_EQ(str.GetType(), LITERAL_STRING);
+    EXPECT_EQ(str.GetLiteralStr(), "Owned");
+    EXPECT_EQ(str.WordSize(), 2);
+
+    // Equal strings are interned to the same payload
+    Operand same = module.EmplaceString(std::string("Own") + "ed");
+    EXPECT_EQ(&same.GetLiteralString(), &str.GetLiteralString());
+    EXPECT_EQ(same, str);
+    EXPECT_FALSE(same < str);
+
+    Operand other = module.EmplaceString("Other");
+    EXPECT_NE(&other.GetLiteralString(), &str.GetLiteralString());
+    EXPECT_NE(other, str);
+    EXPECT_LT(other, str);
 }
 
-TEST(OperandTests, Destructor)
+TEST(OperandTests, LiteralStringEncoding)
 {
-    Operand* strOperand = new Operand("Temporary");
-    delete strOperand;
-    SUCCEED();
+    const LiteralString abcd{"abcd"}, abc{"abc"};
+    EXPECT_EQ(abcd.GetWords(), (std::pmr::vector<uint32_t>{0x64636261u, 0u}));
+    EXPECT_EQ(abc.GetWords(), (std::pmr::vector<uint32_t>{0x00636261u}));
+    EXPECT_EQ(Operand(&abcd).WordSize(), 2);
+    EXPECT_EQ(Operand(&abc).WordSize(), 1);
 }
 
 TEST(OperandTests, DefaultConstructor)
 {
     Operand defaultOperand;
-    EXPECT_EQ(defaultOperand.m_Type, UNINITIALIZED);
-    EXPECT_EQ(defaultOperand.m_LiteralWord, 0);
+    EXPECT_EQ(defaultOperand.GetType(), UNINITIALIZED);
+    EXPECT_EQ(defaultOperand.GetLiteralWord(), 0);
 }
\ No newline at end of file
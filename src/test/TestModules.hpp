@@ -0,0 +1,43 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <Graph.hpp>
+#include <TosaForSpirvCodegen.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tfsc
+{
+
+// Helper method building a Module whose binary spans several of the writer's chunks
+inline std::shared_ptr<spirv::Module> BuildLargeModule()
+{
+    using namespace tosa;
+    constexpr uint32_t elementCount = 4096;
+    auto module = CreateModule(TOSAVersion::v1_0);
+    Graph graph{module, "main_graph"};
+    const Tensor tensor{DataType::int32_t, {1, elementCount}};
+
+    auto output = graph.AddInput(tensor, 0);
+    for (uint32_t idx = 0; idx < 8; ++idx)
+    {
+        std::vector<uint32_t> values(elementCount);
+        for (uint32_t element = 0; element < elementCount; ++element)
+        {
+            values[element] = idx * elementCount + element;
+        }
+        const auto constant = graph.AddTensorConstant(Attribute{values, DataType::int32_t, {1, elementCount}});
+        output = graph.AddAddOperator(output, constant, tensor);
+    }
+    graph.AddOutput(output, 1);
+    graph.FinalizeGraph();
+    return module;
+}
+
+} // namespace tfsc
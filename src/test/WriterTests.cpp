@@ -0,0 +1,459 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "TestModules.hpp"
+
+#include <Graph.hpp>
+#include <Module.hpp>
+#include <TosaForSpirvCodegen.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+
+using namespace tfsc;
+using namespace tosa;
+
+TEST(WriterTests, ParallelWriterIsBitIdentical)
+{
+    const auto module = BuildLargeModule();
+    const auto expected = WriteToBinary(module);
+
+    for (const unsigned int threadCount : {0u, 2u, 3u, 8u})
+    {
+        BinaryWriterOptions options;
+        options.m_ThreadCount = threadCount;
+        // Split even this small Module between the threads
+        options.m_MinInstructionsPerThread = 1;
+        EXPECT_EQ(WriteToBinary(module, options), expected);
+    }
+}
+
+TEST(WriterTests, CompactResIds)
+{
+    const auto module = BuildLargeModule();
+    // Unused Instructions are not written, and should not take up ids
+    using spirv::Operand;
+    const auto u32Type = module->EmplaceInstruction(spv::OpTypeInt, {spirv::RESID, Operand{32u}, Operand{0u}});
+    module->EmplaceInstruction(spv::OpConstant, {u32Type, spirv::RESID, Operand{123456u}});
+
+    const auto expected = WriteToBinary(module);
+    BinaryWriterOptions options;
+    options.m_CompactResIds = true;
+    const auto compact = WriteToBinary(module, options);
+    ASSERT_EQ(compact.size(), expected.size());
+
+    // Only result ids differ, and they are renumbered consistently
+    std::map<uint32_t, uint32_t> renumbered;
+    for (size_t idx = 5; idx < expected.size(); ++idx)
+    {
+        if (expected[idx] != compact[idx])
+        {
+            const auto it = renumbered.emplace(expected[idx], compact[idx]).first;
+            EXPECT_EQ(it->second, compact[idx]);
+        }
+    }
+
+    // Every id below the bound is defined exactly once
+    std::map<spv::Op, uint32_t> resIdPositions;
+    for (const auto& instruction : module->GetSpirvGraph())
+    {
+        if (instruction.HasResId())
+        {
+            resIdPositions[instruction.GetOpCode()] = instruction.m_ResIdPosition;
+        }
+    }
+    const uint32_t bound = compact[3];
+    EXPECT_LT(bound, expected[3]);
+    std::set<uint32_t> definedIds;
+    for (size_t idx = 5; idx < compact.size(); idx += compact[idx] >> 16)
+    {
+        const auto position = resIdPositions.find(static_cast<spv::Op>(compact[idx] & 0xFFFF));
+        if (position != resIdPositions.end())
+        {
+            EXPECT_TRUE(definedIds.insert(compact[idx + 1 + position->second]).second);
+        }
+    }
+    ASSERT_FALSE(definedIds.empty());
+    EXPECT_EQ(definedIds.size(), bound - 1);
+    EXPECT_EQ(*definedIds.begin(), 1u);
+    EXPECT_EQ(*definedIds.rbegin(), bound - 1);
+}
+
+TEST(WriterTests, EliminateDeadInstructions)
+{
+    const auto build = [](bool withDeadCode) {
+        auto module = CreateModule(TOSAVersion::v1_0);
+        Graph graph{module, "main_graph"};
+        const Tensor tensor{DataType::int32_t, {1, 16}};
+        const auto input = graph.AddInput(tensor, 0);
+        const auto values = std::vector<uint32_t>(16, 7);
+        const auto constant = graph.AddTensorConstant(Attribute{values, DataType::int32_t, {1, 16}});
+        if (withDeadCode)
+        {
+            // Neither the result nor the constant or types only it uses reach an output
+            const auto unused = graph.AddTensorConstant(Attribute{std::vector<int8_t>(8, 3), DataType::int8_t, {8}});
+            graph.AddAddOperator(unused, unused, Tensor{DataType::int8_t, {8}});
+        }
+        graph.AddOutput(graph.AddAddOperator(input, constant, tensor), 1);
+        graph.FinalizeGraph();
+        return module;
+    };
+
+    const auto expected = build(false);
+    const auto module = build(true);
+    const auto before = GetBinarySizeInWords(module);
+    const auto report = EliminateDeadInstructions(module);
+    EXPECT_GT(report.m_RemovedInstructions, 0u);
+    EXPECT_EQ(report.m_SavedBytes, (before - GetBinarySizeInWords(module)) * sizeof(uint32_t));
+    EXPECT_EQ(module->GetSpirvGraph().size(), expected->GetSpirvGraph().size());
+
+    // Only the numbering differs from the Module built without dead code, and closes up once compacted
+    BinaryWriterOptions options;
+    options.m_CompactResIds = true;
+    EXPECT_EQ(WriteToBinary(module, options), WriteToBinary(expected, options));
+    const auto binary = WriteToBinary(module);
+    EXPECT_EQ(binary.size(), GetBinarySizeInWords(expected));
+    EXPECT_GE(binary[3], module->GetResIdBound());
+
+    // Running the pass again finds nothing left to remove
+    EXPECT_EQ(EliminateDeadInstructions(module).m_RemovedInstructions, 0u);
+
+    // An unused operator computed from constants only is removed from a multi-graph Module too
+    const Tensor tensor{DataType::int32_t, {1, 16}};
+    auto multiGraph = CreateModule(TOSAVersion::v1_0);
+    for (const bool withDeadCode : {false, true})
+    {
+        Graph graph{multiGraph, withDeadCode ? "second" : "first"};
+        const auto input = graph.AddInput(tensor, 0);
+        if (withDeadCode)
+        {
+            const Attribute values{std::vector<uint32_t>(16, 9), DataType::int32_t, {1, 16}};
+            graph.AddAbsOperator(graph.AddTensorConstant(values), tensor);
+        }
+        graph.AddOutput(graph.AddAbsOperator(input, tensor), 1);
+        graph.FinalizeGraph();
+    }
+    const auto multiGraphBefore = GetBinarySizeInWords(multiGraph);
+    const auto multiGraphReport = EliminateDeadInstructions(multiGraph);
+    EXPECT_GT(multiGraphReport.m_RemovedInstructions, 0u);
+    EXPECT_EQ(multiGraphReport.m_SavedBytes, (multiGraphBefore - GetBinarySizeInWords(multiGraph)) * sizeof(uint32_t));
+    const auto [operatorsBegin, operatorsEnd] = multiGraph->GetInstructionsOfType(spv::OpExtInst);
+    EXPECT_EQ(std::distance(operatorsBegin, operatorsEnd), 2);
+
+    // The pass does not depend on how the writer splits the graphs, so an operator shared by several graphs, which
+    // cannot be written, does not stop it
+    auto shared = CreateModule(TOSAVersion::v1_0);
+    const Attribute sharedValues{std::vector<uint32_t>(16, 7), DataType::int32_t, {1, 16}};
+    for (const bool withDeadCode : {false, true})
+    {
+        Graph graph{shared, withDeadCode ? "second" : "first"};
+        const auto input = graph.AddInput(tensor, 0);
+        if (withDeadCode)
+        {
+            graph.AddAbsOperator(input, tensor);
+        }
+        const auto constant = graph.AddTensorConstant(sharedValues);
+        graph.AddOutput(graph.AddAddOperator(constant, constant, tensor), 1);
+        graph.FinalizeGraph();
+    }
+    ASSERT_THROW(WriteToBinary(shared), std::runtime_error);
+    const auto sharedReport = EliminateDeadInstructions(shared);
+    EXPECT_EQ(sharedReport.m_RemovedInstructions, 1u);
+    EXPECT_GT(sharedReport.m_SavedBytes, 0u);
+}
+
+TEST(WriterTests, EliminateNeverEmittedInstructions)
+{
+    auto module = CreateModule(TOSAVersion::v1_0);
+    Graph graph{module, "main_graph"};
+    const Tensor tensor{DataType::int32_t, {1, 16}};
+    graph.AddOutput(graph.AddAbsOperator(graph.AddInput(tensor, 0), tensor), 1);
+    // A constant no operator uses is removed, but was never part of the binary
+    graph.AddTensorConstant(Attribute{std::vector<int8_t>(8, 3), DataType::int8_t, {8}});
+    graph.FinalizeGraph();
+
+    const auto before = GetBinarySizeInWords(module);
+    const auto report = EliminateDeadInstructions(module);
+    EXPECT_GT(report.m_RemovedInstructions, 0u);
+    EXPECT_EQ(GetBinarySizeInWords(module), before);
+    EXPECT_EQ(report.m_SavedBytes, 0u);
+}
+
+TEST(WriterTests, LinkModules)
+{
+    const Tensor tensor{DataType::int32_t, {1, 16}};
+    const Attribute attribute{std::vector<uint32_t>(16, 7), DataType::int32_t, {1, 16}};
+
+    // Reference: the whole network built in a single Module
+    auto expected = CreateModule(TOSAVersion::v1_0);
+    {
+        Graph graph{expected, "main_graph"};
+        const auto input = graph.AddInput(tensor, 0);
+        auto output = graph.AddAddOperator(input, graph.AddGraphConstant(tensor), tensor);
+        output = graph.AddAddOperator(output, graph.AddGraphConstant(tensor), tensor);
+        output = graph.AddAddOperator(output, graph.AddTensorConstant(attribute), tensor);
+        graph.AddOutput(output, 1);
+        graph.FinalizeGraph();
+    }
+
+    // The constants of the second half are built in a separate Module, then linked in
+    auto module = CreateModule(TOSAVersion::v1_0);
+    Graph graph{module, "main_graph"};
+    const auto input = graph.AddInput(tensor, 0);
+    auto output = graph.AddAddOperator(input, graph.AddGraphConstant(tensor), tensor);
+
+    auto part = CreateModule(TOSAVersion::v1_0);
+    Graph partGraph{part, "part"};
+    const auto graphConstant = partGraph.AddGraphConstant(tensor);
+    const auto tensorConstant = partGraph.AddTensorConstant(attribute);
+    const auto partSize = part->GetSpirvGraph().size();
+
+    const auto result = graph.Link(part);
+    EXPECT_EQ(result.m_Instructions.size(), partSize);
+    EXPECT_EQ(part->GetSpirvGraph().size(), partSize);
+    EXPECT_EQ(result.m_GraphConstantOffset, 1u);
+    EXPECT_EQ(result.m_NextGraphConstantId, 2u);
+    // The module header and the types shared with the first half are not imported again
+    EXPECT_LT(result.m_ImportedInstructions, partSize);
+
+    output = graph.AddAddOperator(output, result.m_Instructions.at(graphConstant), tensor);
+    output = graph.AddAddOperator(output, result.m_Instructions.at(tensorConstant), tensor);
+    graph.AddOutput(output, 1);
+    graph.FinalizeGraph();
+
+    EXPECT_EQ(module->GetSpirvGraph().size(), expected->GetSpirvGraph().size());
+    BinaryWriterOptions options;
+    options.m_CompactResIds = true;
+    EXPECT_EQ(WriteToBinary(module, options), WriteToBinary(expected, options));
+
+    EXPECT_THROW(LinkModules(part, part), std::runtime_error);
+}
+
+TEST(WriterTests, ModuleFork)
+{
+    const Tensor tensor{DataType::int32_t, {1, 16}};
+    const auto buildBase = [&](const std::shared_ptr<spirv::Module>& module) {
+        Graph graph{module, "main_graph"};
+        const auto input = graph.AddInput(tensor, 0);
+        graph.AddAddOperator(input, graph.AddGraphConstant(tensor), tensor);
+        return graph;
+    };
+    // Each variant adds a differently shifted constant, with types and an operator the base does not have
+    const auto completeVariant = [&](Graph graph, const ResId base, const uint32_t shift) {
+        const Attribute values{std::vector<uint32_t>(16, shift), DataType::int32_t, {1, 16}};
+        const auto constant = graph.AddTensorConstant(values);
+        const auto shifted = graph.AddArithmeticRightShiftOperator(base,
+                                                                   constant,
+                                                                   Attribute{{shift % 2}, DataType::bool_t, {1}},
+                                                                   tensor);
+        graph.AddOutput(shifted, 1);
+        graph.FinalizeGraph();
+    };
+
+    auto module = CreateModule(TOSAVersion::v1_0);
+    const auto base = buildBase(module);
+    const ResId baseOutput = &(*module->GetInstructionsOfType(spv::OpExtInst).first);
+    const auto baseSize = module->GetSpirvGraph().size();
+    const auto baseBound = module->GetResIdBound();
+
+    // The variants coexist, each in its own fork sharing the Instructions of the base
+    std::vector<Graph> variants;
+    for (const uint32_t shift : {1u, 2u, 3u})
+    {
+        variants.push_back(base.Fork());
+        completeVariant(variants.back(), baseOutput, shift);
+    }
+
+    for (uint32_t shift = 1; shift <= 3; ++shift)
+    {
+        const auto& variant = variants[shift - 1];
+
+        // Building the variant from scratch gives the same binary
+        auto expected = CreateModule(TOSAVersion::v1_0);
+        const auto expectedBase = buildBase(expected);
+        completeVariant(expectedBase, &(*expected->GetInstructionsOfType(spv::OpExtInst).first), shift);
+        EXPECT_EQ(WriteToBinary(variant.GetModule()), WriteToBinary(expected));
+        EXPECT_EQ(&(*variant.GetModule()->GetInstructionsOfType(spv::OpExtInst).first), baseOutput);
+    }
+
+    // The base is left unchanged and can still be completed
+    EXPECT_EQ(module->GetSpirvGraph().size(), baseSize);
+    EXPECT_EQ(module->GetResIdBound(), baseBound);
+    completeVariant(base, baseOutput, 1);
+    EXPECT_EQ(WriteToBinary(module), WriteToBinary(variants.front().GetModule()));
+}
+
+TEST(WriterTests, MultipleGraphs)
+{
+    const Tensor tensor{DataType::int32_t, {1, 16}};
+    const Attribute values{std::vector<uint32_t>(16, 7), DataType::int32_t, {1, 16}};
+    const auto addGraph = [&](const std::shared_ptr<spirv::Module>& module, const std::string& name, uint32_t adds) {
+        Graph graph{module, name};
+        auto output = graph.AddInput(tensor, 0);
+        const auto constant = graph.AddTensorConstant(values);
+        for (uint32_t idx = 0; idx < adds; ++idx)
+        {
+            output = graph.AddAddOperator(output, constant, tensor);
+        }
+        graph.AddOutput(output, 1);
+        graph.FinalizeGraph();
+    };
+
+    auto module = CreateModule(TOSAVersion::v1_0);
+    addGraph(module, "prefill", 2);
+    addGraph(module, "decode", 3);
+    ASSERT_EQ(module->GetGraphDefinitions().size(), 2u);
+
+    // The types and constants are shared rather than duplicated in a Module per graph
+    auto prefill = CreateModule(TOSAVersion::v1_0);
+    addGraph(prefill, "prefill", 2);
+    auto decode = CreateModule(TOSAVersion::v1_0);
+    addGraph(decode, "decode", 3);
+    const auto binary = WriteToBinary(module);
+    EXPECT_LT(binary.size(), WriteToBinary(prefill).size() + WriteToBinary(decode).size());
+    EXPECT_EQ(binary.size(), GetBinarySizeInWords(module));
+    EXPECT_EQ(WriteToBinary(module->Freeze()), binary);
+
+    // Each graph is written between its OpGraphARM and OpGraphEndARM, with its own inputs, operators and outputs
+    unsigned int entryPoints = 0;
+    const auto getGraphOpcodes = [&entryPoints](const std::vector<uint32_t>& words) {
+        std::vector<std::map<uint32_t, unsigned int>> opcodes;
+        entryPoints = 0;
+        bool inGraph = false;
+        for (std::size_t idx = 5; idx < words.size(); idx += words[idx] >> 16)
+        {
+            const auto opCode = words[idx] & 0xFFFF;
+            entryPoints += opCode == spv::OpGraphEntryPointARM;
+            if (opCode == spv::OpGraphARM)
+            {
+                EXPECT_FALSE(inGraph);
+                inGraph = true;
+                opcodes.emplace_back();
+            }
+            else if (opCode == spv::OpGraphEndARM)
+            {
+                EXPECT_TRUE(inGraph);
+                inGraph = false;
+            }
+            else if (inGraph)
+            {
+                ++opcodes.back()[opCode];
+            }
+        }
+        return opcodes;
+    };
+    auto graphOpcodes = getGraphOpcodes(binary);
+    EXPECT_EQ(entryPoints, 2u);
+    ASSERT_EQ(graphOpcodes.size(), 2u);
+    EXPECT_EQ(graphOpcodes[0][spv::OpExtInst], 2u);
+    EXPECT_EQ(graphOpcodes[1][spv::OpExtInst], 3u);
+    for (auto& opcodes : graphOpcodes)
+    {
+        EXPECT_EQ(opcodes[spv::OpGraphInputARM], 1u);
+        EXPECT_EQ(opcodes[spv::OpGraphSetOutputARM], 1u);
+    }
+
+    // An operator computed from constants only would be shared by the graphs using it, which the writer rejects
+    auto shared = CreateModule(TOSAVersion::v1_0);
+    for (const std::string name : {"first", "second"})
+    {
+        Graph graph{shared, name};
+        graph.AddInput(tensor, 0);
+        const auto constant = graph.AddTensorConstant(values);
+        graph.AddOutput(graph.AddAddOperator(constant, constant, tensor), 1);
+        graph.FinalizeGraph();
+    }
+    EXPECT_THROW(WriteToBinary(shared), std::runtime_error);
+
+    // Operators whose results are unused are written in the body of the graph they depend on, as with a single graph
+    const auto addGraphWithUnusedOperator = [&](const std::shared_ptr<spirv::Module>& module, const std::string& name) {
+        Graph graph{module, name};
+        const auto input = graph.AddInput(tensor, 0);
+        graph.AddAbsOperator(input, tensor);
+        graph.AddOutput(graph.AddAddOperator(input, graph.AddTensorConstant(values), tensor), 1);
+        graph.FinalizeGraph();
+    };
+    auto unused = CreateModule(TOSAVersion::v1_0);
+    addGraphWithUnusedOperator(unused, "first");
+    addGraph(unused, "second", 3);
+    auto unusedAlone = CreateModule(TOSAVersion::v1_0);
+    addGraphWithUnusedOperator(unusedAlone, "first");
+    EXPECT_EQ(getGraphOpcodes(WriteToBinary(unusedAlone)).at(0)[spv::OpExtInst], 2u);
+    graphOpcodes = getGraphOpcodes(WriteToBinary(unused));
+    ASSERT_EQ(graphOpcodes.size(), 2u);
+    EXPECT_EQ(graphOpcodes[0][spv::OpExtInst], 2u);
+    EXPECT_EQ(graphOpcodes[1][spv::OpExtInst], 3u);
+    EXPECT_EQ(WriteToBinary(unused).size(), GetBinarySizeInWords(unused));
+
+    // An unused operator computed from constants only is written in the graph finalized after it was emplaced,
+    // as with a single graph, and so are the unused operators depending on it
+    {
+        Graph graph{unused, "third"};
+        const Attribute otherValues{std::vector<uint32_t>(16, 9), DataType::int32_t, {1, 16}};
+        graph.AddAbsOperator(graph.AddAbsOperator(graph.AddTensorConstant(otherValues), tensor), tensor);
+        graph.AddOutput(graph.AddInput(tensor, 0), 1);
+        graph.FinalizeGraph();
+    }
+    addGraph(unused, "fourth", 1);
+    graphOpcodes = getGraphOpcodes(WriteToBinary(unused));
+    ASSERT_EQ(graphOpcodes.size(), 4u);
+    EXPECT_EQ(graphOpcodes[2][spv::OpExtInst], 2u);
+    EXPECT_EQ(graphOpcodes[3][spv::OpExtInst], 1u);
+    EXPECT_EQ(WriteToBinary(unused).size(), GetBinarySizeInWords(unused));
+
+    // Graph constants are numbered across the Module, so the graphs bind distinct external constants
+    auto weighted = CreateModule(TOSAVersion::v1_0);
+    for (const std::string name : {"first", "second"})
+    {
+        Graph graph{weighted, name};
+        const auto input = graph.AddInput(tensor, 0);
+        graph.AddOutput(graph.AddAddOperator(input, graph.AddGraphConstant(tensor), tensor), 1);
+        graph.FinalizeGraph();
+    }
+    std::set<uint32_t> graphConstantIds;
+    const auto [constantsBegin, constantsEnd] = weighted->GetInstructionsOfType(spv::OpGraphConstantARM);
+    for (auto it = constantsBegin; it != constantsEnd; ++it)
+    {
+        graphConstantIds.insert(it->m_Operands[2].GetLiteralWord());
+    }
+    EXPECT_EQ(graphConstantIds, (std::set<uint32_t>{0, 1}));
+    EXPECT_EQ(weighted->GetGraphConstantIdBound(), 2u);
+    EXPECT_EQ(WriteToBinary(weighted).size(), GetBinarySizeInWords(weighted));
+}
+
+TEST(WriterTests, FrozenModule)
+{
+    auto module = BuildLargeModule();
+    const auto expected = WriteToBinary(module);
+    const auto frozen = module->Freeze();
+
+    ASSERT_EQ(frozen.m_OperandOffsets.size(), frozen.GetInstructionCount() + 1);
+    ASSERT_EQ(frozen.m_OperandTypes.size(), frozen.m_OperandOffsets.back());
+    ASSERT_EQ(frozen.m_OperandValues.size(), frozen.m_OperandOffsets.back());
+    ASSERT_EQ(frozen.m_StringWords.size(), frozen.m_StringOffsets.back());
+    EXPECT_EQ(frozen.m_ResIdBound, expected[3]);
+    // Every operand referring to an Instruction resolves to one that has a result id
+    for (std::size_t idx = 0; idx < frozen.GetInstructionCount(); ++idx)
+    {
+        for (auto operand = frozen.m_OperandOffsets[idx]; operand < frozen.m_OperandOffsets[idx + 1]; ++operand)
+        {
+            if (frozen.m_OperandTypes[operand] == spirv::INSTRUCTION_POINTER)
+            {
+                ASSERT_LT(frozen.m_OperandValues[operand], frozen.GetInstructionCount());
+                EXPECT_NE(frozen.m_ResIds[frozen.m_OperandValues[operand]], 0u);
+            }
+            else if (frozen.m_OperandTypes[operand] == spirv::RES_ID)
+            {
+                EXPECT_EQ(frozen.m_OperandValues[operand], idx);
+            }
+        }
+    }
+
+    // The view owns its data, so it outlives the Module
+    module.reset();
+    EXPECT_EQ(WriteToBinary(frozen), expected);
+}
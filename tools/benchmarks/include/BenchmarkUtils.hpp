@@ -0,0 +1,89 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <Module.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace tfsc::benchmarks
+{
+
+/// Options shared by all benchmarks, set from the command line
+struct BenchmarkOptions
+{
+    /// Number of timed repetitions of each benchmark, the fastest run is reported
+    unsigned int m_Iterations = 5;
+    /// Number of operators in the synthetic networks
+    uint32_t m_OperatorCount = 2000;
+};
+
+/// Time a callable over a number of runs
+/// @param[in] function callable to time
+/// @param[in] iterations number of runs
+/// @return Duration of the fastest run in milliseconds
+template <typename Function>
+double MeasureMilliseconds(Function&& function, const unsigned int iterations)
+{
+    double fastest = std::numeric_limits<double>::max();
+    for (unsigned int iteration = 0; iteration < std::max(iterations, 1u); ++iteration)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto stop = std::chrono::steady_clock::now();
+        fastest = std::min(fastest, std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+    return fastest;
+}
+
+/// Print a single benchmark result line
+/// @param[in] benchmark name of the benchmark
+/// @param[in] variant name of the implementation or configuration measured
+/// @param[in] value measured value
+/// @param[in] unit unit of the measured value
+void PrintResult(const std::string& benchmark, const std::string& variant, double value, const std::string& unit = "ms");
+
+/// Number of calls to the global operator new made by the process so far
+/// The benchmark executable replaces the global allocation functions to count them.
+/// @return allocation count
+uint64_t GetAllocationCount();
+
+/// Reset the peak resident set size of the process, where supported by the platform
+/// @return true if the peak was reset and GetPeakRssKb measures from this point
+bool ResetPeakRss();
+
+/// Peak resident set size of the process
+/// @return peak resident set size in kilobytes, or 0 if unsupported
+uint64_t GetPeakRssKb();
+
+/// Build a finalized Module containing a chain of Conv2d, Rescale, Add and Clamp blocks
+/// Each block adds four operators, mirroring the structure of a typical quantized network.
+/// @param[in] operatorCount approximate number of operators in the graph
+/// @param[in] moduleOptions construction options of the Module
+/// @param[in] reserve pre-size the Module through a tosa::GraphCapacity hint
+/// @return Module containing the finalized graph
+std::shared_ptr<spirv::Module> BuildConvNetwork(uint32_t operatorCount,
+                                                const spirv::ModuleOptions& moduleOptions = spirv::ModuleOptions{},
+                                                bool reserve = false);
+
+/// Benchmarks of Module Instruction emplacement
+/// @param[in] options benchmark options
+void RunModuleBenchmarks(const BenchmarkOptions& options);
+
+/// Benchmarks of the Graph API
+/// @param[in] options benchmark options
+void RunGraphBenchmarks(const BenchmarkOptions& options);
+
+/// Benchmarks of the SPIR-V binary writer on Modules of about 100k Instructions
+/// @param[in] options benchmark options
+void RunWriterBenchmarks(const BenchmarkOptions& options);
+
+} // namespace tfsc::benchmarks
@@ -0,0 +1,71 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <BenchmarkUtils.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replacements of the global allocation functions, counting every allocation made by the benchmarks.
+// Kept in their own translation unit so that the compiler cannot pair them with inlined standard library code.
+
+namespace
+{
+std::atomic<uint64_t> g_AllocationCount{0};
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+    g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc requires the size to be a multiple of the alignment
+    if (void* ptr = std::aligned_alloc(align, (std::max(size, std::size_t{1}) + align - 1) / align * align))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace tfsc::benchmarks
+{
+
+uint64_t GetAllocationCount()
+{
+    return g_AllocationCount.load(std::memory_order_relaxed);
+}
+
+} // namespace tfsc::benchmarks
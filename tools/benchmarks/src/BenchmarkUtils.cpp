@@ -0,0 +1,110 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <BenchmarkUtils.hpp>
+
+#include <Graph.hpp>
+#include <TosaForSpirvCodegen.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace tfsc::benchmarks
+{
+
+using namespace tfsc::tosa;
+
+void PrintResult(const std::string& benchmark, const std::string& variant, const double value, const std::string& unit)
+{
+    std::cout << std::left << std::setw(32) << benchmark << std::setw(32) << variant << std::right << std::fixed
+              << std::setprecision(3) << std::setw(14) << value << " " << unit << std::endl;
+}
+
+bool ResetPeakRss()
+{
+    // Writing 5 to clear_refs resets VmHWM on Linux
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.flush();
+    return clearRefs.good();
+}
+
+uint64_t GetPeakRssKb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind("VmHWM:", 0) == 0)
+        {
+            return std::stoull(line.substr(6));
+        }
+    }
+    return 0;
+}
+
+std::shared_ptr<spirv::Module>
+BuildConvNetwork(const uint32_t operatorCount, const spirv::ModuleOptions& moduleOptions, const bool reserve)
+{
+    auto module = CreateModule(TOSAVersion::v1_0, moduleOptions);
+    // Each block adds four operators, the operator and constant tensors and a weight and bias constant
+    const uint32_t blockCount = std::max(operatorCount / 4, 1u);
+    GraphCapacity capacity;
+    if (reserve)
+    {
+        capacity.m_OperatorCount = blockCount * 4;
+        capacity.m_TensorCount = blockCount * 6;
+        capacity.m_ConstantCount = blockCount * 2;
+    }
+    Graph graph{module, "main_graph", capacity};
+
+    const Tensor tensorInt8{DataType::int8_t, {1, 16, 16, 8}};
+    const Tensor tensorInt32{DataType::int32_t, {1, 16, 16, 8}};
+    auto input = graph.AddInput(tensorInt8, 0);
+    const auto residual = graph.AddInput(tensorInt8, 1);
+    const auto zeroPoint = graph.AddTensorConstant(Attribute{{0u}, DataType::int8_t, {1}});
+    const auto multiplier = graph.AddTensorConstant(Attribute{{1073741824u}, DataType::int32_t, {1}});
+    const auto shift = graph.AddTensorConstant(Attribute{{30u}, DataType::int8_t, {1}});
+
+    for (uint32_t block = 0; block < blockCount; ++block)
+    {
+        const auto weight = graph.AddGraphConstant(Tensor{DataType::int8_t, {8, 3, 3, 8}});
+        const auto bias = graph.AddTensorConstant(Attribute{{block, 1u, 2u, 3u, 4u, 5u, 6u, 7u}, DataType::int32_t, {8}});
+        const auto conv = graph.AddConv2dOperator(input,
+                                                  weight,
+                                                  bias,
+                                                  zeroPoint,
+                                                  zeroPoint,
+                                                  Attribute{{1u, 1u, 1u, 1u}, DataType::uint32_t, {4}},
+                                                  Attribute{{1u, 1u}, DataType::uint32_t, {2}},
+                                                  Attribute{{1u, 1u}, DataType::uint32_t, {2}},
+                                                  Attribute{{1u}, DataType::uint32_t, {1}},
+                                                  Attribute{{0u}, DataType::bool_t, {1}},
+                                                  tensorInt32);
+        const auto rescale = graph.AddRescaleOperator(conv,
+                                                      multiplier,
+                                                      shift,
+                                                      zeroPoint,
+                                                      zeroPoint,
+                                                      Attribute{{1u}, DataType::bool_t, {1}},
+                                                      Attribute{{0u}, DataType::uint32_t, {1}},
+                                                      Attribute{{0u}, DataType::bool_t, {1}},
+                                                      Attribute{{0u}, DataType::bool_t, {1}},
+                                                      Attribute{{0u}, DataType::bool_t, {1}},
+                                                      tensorInt8);
+        const auto add = graph.AddAddOperator(rescale, residual, tensorInt8);
+        input = graph.AddClampOperator(add,
+                                       Attribute{{0u}, DataType::int8_t, {1}},
+                                       Attribute{{127u}, DataType::int8_t, {1}},
+                                       Attribute{{0u}, DataType::uint32_t, {1}},
+                                       tensorInt8);
+    }
+    graph.AddOutput(input, 2);
+    graph.FinalizeGraph();
+    return module;
+}
+
+} // namespace tfsc::benchmarks
@@ -0,0 +1,267 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <BenchmarkUtils.hpp>
+
+#include <Graph.hpp>
+#include <TosaForSpirvCodegen.hpp>
+
+#include <string>
+#include <thread>
+
+namespace tfsc::benchmarks
+{
+
+using namespace tfsc::tosa;
+
+namespace
+{
+
+/// Measure the heap allocations and time of repeatedly chaining Conv2d operators in a single Graph
+/// All types, constants and attributes are shared between calls, so every Instruction except the
+/// OpExtInst of the operator itself is found in the Module.
+void MeasureConv2dAllocations(const uint32_t callCount)
+{
+    auto module = CreateModule(TOSAVersion::v1_0);
+    Graph graph{module, "main_graph"};
+
+    const Tensor tensorInt8{DataType::int8_t, {1, 16, 16, 8}};
+    auto input = graph.AddInput(tensorInt8, 0);
+    const auto weight = graph.AddGraphConstant(Tensor{DataType::int8_t, {8, 3, 3, 8}});
+    const auto bias = graph.AddTensorConstant(Attribute{{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u}, DataType::int32_t, {8}});
+    const auto zeroPoint = graph.AddTensorConstant(Attribute{{0u}, DataType::int8_t, {1}});
+    const Attribute pad{{1u, 1u, 1u, 1u}, DataType::uint32_t, {4}};
+    const Attribute stride{{1u, 1u}, DataType::uint32_t, {2}};
+    const Attribute dilation{{1u, 1u}, DataType::uint32_t, {2}};
+    const Attribute accType{{1u}, DataType::uint32_t, {1}};
+    const Attribute localBound{{0u}, DataType::bool_t, {1}};
+
+    const auto addConv2d = [&](const ResId& conv2dInput) {
+        return graph.AddConv2dOperator(conv2dInput,
+                                       weight,
+                                       bias,
+                                       zeroPoint,
+                                       zeroPoint,
+                                       pad,
+                                       stride,
+                                       dilation,
+                                       accType,
+                                       localBound,
+                                       tensorInt8);
+    };
+
+    // The first call creates the shared types and constants
+    input = addConv2d(input);
+
+    const auto allocationsBefore = GetAllocationCount();
+    const auto milliseconds = MeasureMilliseconds(
+        [&]() {
+            for (uint32_t call = 0; call < callCount; ++call)
+            {
+                input = addConv2d(input);
+            }
+        },
+        1);
+    const auto allocations = GetAllocationCount() - allocationsBefore;
+
+    PrintResult("AddConv2dOperator", "allocations per call", static_cast<double>(allocations) / callCount, "");
+    PrintResult("AddConv2dOperator", "time per call", milliseconds * 1000.0 / callCount, "us");
+    PrintResult("AddConv2dOperator", "type cache hit rate", module->GetTypeCacheStats().GetHitRate() * 100.0, "%");
+}
+
+/// Measure the time of adding a large tensor constant, whose elements are emplaced as scalar OpConstants
+void MeasureTensorConstant(const unsigned int iterations)
+{
+    constexpr uint32_t elementCount = 64 * 1024;
+    std::vector<uint32_t> values(elementCount);
+    for (uint32_t idx = 0; idx < elementCount; ++idx)
+    {
+        values[idx] = idx % 4096;
+    }
+    const Attribute attribute{values, DataType::int32_t, {elementCount}};
+
+    const auto milliseconds = MeasureMilliseconds(
+        [&]() {
+            auto module = CreateModule(TOSAVersion::v1_0);
+            Graph graph{module, "main_graph"};
+            graph.AddTensorConstant(attribute);
+        },
+        iterations);
+    PrintResult("AddTensorConstant", "64k elements time", milliseconds);
+}
+
+/// Measure the heap allocations, time and peak resident set size of building and destroying a network
+void MeasureModuleMemory(const uint32_t operatorCount,
+                         const bool useArena,
+                         const bool reserve,
+                         const unsigned int iterations)
+{
+    spirv::ModuleOptions moduleOptions;
+    moduleOptions.m_UseArena = useArena;
+    const std::string variant = std::string(useArena ? "arena" : "default") + (reserve ? " reserved" : "");
+
+    const bool peakReset = ResetPeakRss();
+    const auto rssBefore = GetPeakRssKb();
+    const auto allocationsBefore = GetAllocationCount();
+    BuildConvNetwork(operatorCount, moduleOptions, reserve);
+    const auto allocations = GetAllocationCount() - allocationsBefore;
+    const auto peakRss = std::max(GetPeakRssKb(), rssBefore) - rssBefore;
+
+    const auto milliseconds =
+        MeasureMilliseconds([&]() { BuildConvNetwork(operatorCount, moduleOptions, reserve); }, iterations);
+
+    PrintResult("Build and destroy network", variant + " allocations", static_cast<double>(allocations), "");
+    if (peakReset)
+    {
+        PrintResult("Build and destroy network", variant + " peak RSS growth", static_cast<double>(peakRss), "kB");
+    }
+    PrintResult("Build and destroy network", variant + " time", milliseconds);
+}
+
+/// Measure the time of building a network of independent Conv2d and Clamp chains in one Graph, one chain per thread
+/// The chains share their types and attribute constants, so the threads contend on the same Module entries.
+void MeasureConcurrentBuild(const uint32_t operatorCount, const unsigned int threadCount, const unsigned int iterations)
+{
+    spirv::ModuleOptions moduleOptions;
+    moduleOptions.m_UseArena = true;
+    moduleOptions.m_Concurrent = threadCount > 1;
+    const uint32_t blocksPerThread = std::max(operatorCount / 2 / threadCount, 1u);
+
+    const auto milliseconds = MeasureMilliseconds(
+        [&]() {
+            auto module = CreateModule(TOSAVersion::v1_0, moduleOptions);
+            Graph graph{module, "main_graph"};
+            const Tensor tensorInt8{DataType::int8_t, {1, 16, 16, 8}};
+            const auto input = graph.AddInput(tensorInt8, 0);
+            const auto zeroPoint = graph.AddTensorConstant(Attribute{{0u}, DataType::int8_t, {1}});
+
+            std::vector<ResId> outputs(threadCount);
+            auto buildChain = [&](const unsigned int chain) {
+                auto output = input;
+                for (uint32_t block = 0; block < blocksPerThread; ++block)
+                {
+                    const auto weight = graph.AddGraphConstant(Tensor{DataType::int8_t, {8, 3, 3, 8}});
+                    const Attribute biasValues{{chain, block, 2u, 3u, 4u, 5u, 6u, 7u}, DataType::int32_t, {8}};
+                    const auto bias = graph.AddTensorConstant(biasValues);
+                    const auto conv = graph.AddConv2dOperator(output,
+                                                              weight,
+                                                              bias,
+                                                              zeroPoint,
+                                                              zeroPoint,
+                                                              Attribute{{1u, 1u, 1u, 1u}, DataType::uint32_t, {4}},
+                                                              Attribute{{1u, 1u}, DataType::uint32_t, {2}},
+                                                              Attribute{{1u, 1u}, DataType::uint32_t, {2}},
+                                                              Attribute{{1u}, DataType::uint32_t, {1}},
+                                                              Attribute{{0u}, DataType::bool_t, {1}},
+                                                              tensorInt8);
+                    output = graph.AddClampOperator(conv,
+                                                    Attribute{{0u}, DataType::int8_t, {1}},
+                                                    Attribute{{127u}, DataType::int8_t, {1}},
+                                                    Attribute{{0u}, DataType::uint32_t, {1}},
+                                                    tensorInt8);
+                }
+                outputs[chain] = output;
+            };
+
+            std::vector<std::thread> threads;
+            for (unsigned int chain = 1; chain < threadCount; ++chain)
+            {
+                threads.emplace_back(buildChain, chain);
+            }
+            buildChain(0);
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            for (unsigned int chain = 0; chain < threadCount; ++chain)
+            {
+                graph.AddOutput(outputs[chain], chain + 1);
+            }
+            graph.FinalizeGraph();
+        },
+        iterations);
+    PrintResult("Build network", std::to_string(threadCount) + " threads time", milliseconds);
+}
+
+/// Measure the time of completing variants of a network that only differ in their last operator, either in forks of
+/// the Module holding the shared part, all kept alive, or by building every variant from scratch
+void MeasureForkVariants(const uint32_t operatorCount, const unsigned int iterations)
+{
+    constexpr uint32_t variantCount = 16;
+    const Tensor tensorInt8{DataType::int8_t, {1, 16, 16, 8}};
+    const auto buildBase = [&](const std::shared_ptr<spirv::Module>& module) {
+        Graph graph{module, "main_graph"};
+        auto output = graph.AddInput(tensorInt8, 0);
+        for (uint32_t block = 0; block < operatorCount; ++block)
+        {
+            output = graph.AddClampOperator(output,
+                                            Attribute{{block % 64}, DataType::int8_t, {1}},
+                                            Attribute{{127u}, DataType::int8_t, {1}},
+                                            Attribute{{0u}, DataType::uint32_t, {1}},
+                                            tensorInt8);
+        }
+        return std::make_pair(graph, output);
+    };
+    const auto completeVariant = [&](Graph graph, const ResId output, const uint32_t variant) {
+        graph.AddOutput(graph.AddClampOperator(output,
+                                               Attribute{{0u}, DataType::int8_t, {1}},
+                                               Attribute{{64u + variant}, DataType::int8_t, {1}},
+                                               Attribute{{0u}, DataType::uint32_t, {1}},
+                                               tensorInt8),
+                        1);
+        graph.FinalizeGraph();
+    };
+
+    const auto scratchMilliseconds = MeasureMilliseconds(
+        [&]() {
+            for (uint32_t variant = 0; variant < variantCount; ++variant)
+            {
+                auto module = CreateModule(TOSAVersion::v1_0);
+                const auto [graph, output] = buildBase(module);
+                completeVariant(graph, output, variant);
+                WriteToBinary(module);
+            }
+        },
+        iterations);
+    const auto forkMilliseconds = MeasureMilliseconds(
+        [&]() {
+            auto module = CreateModule(TOSAVersion::v1_0);
+            const auto [graph, output] = buildBase(module);
+            std::vector<Graph> variants;
+            for (uint32_t variant = 0; variant < variantCount; ++variant)
+            {
+                variants.push_back(graph.Fork());
+                completeVariant(variants.back(), output, variant);
+                WriteToBinary(variants.back().GetModule());
+            }
+        },
+        iterations);
+    PrintResult("Build 16 variants", "from scratch time", scratchMilliseconds);
+    PrintResult("Build 16 variants", "forking time", forkMilliseconds);
+}
+
+} // namespace
+
+void RunGraphBenchmarks(const BenchmarkOptions& options)
+{
+    MeasureConv2dAllocations(options.m_OperatorCount);
+    MeasureTensorConstant(options.m_Iterations);
+
+    for (const bool reserve : {false, true})
+    {
+        MeasureModuleMemory(options.m_OperatorCount, false, reserve, options.m_Iterations);
+        MeasureModuleMemory(options.m_OperatorCount, true, reserve, options.m_Iterations);
+    }
+
+    for (const unsigned int threadCount : {1u, 4u})
+    {
+        MeasureConcurrentBuild(options.m_OperatorCount, threadCount, options.m_Iterations);
+    }
+
+    MeasureForkVariants(options.m_OperatorCount, options.m_Iterations);
+}
+
+} // namespace tfsc::benchmarks
@@ -0,0 +1,185 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <BenchmarkUtils.hpp>
+
+#include <algorithm>
+#include <list>
+#include <set>
+#include <stdexcept>
+
+namespace tfsc::benchmarks
+{
+
+using namespace tfsc::spirv;
+
+namespace
+{
+
+/// Reference implementation of the Module Instruction storage prior to hash-consing.
+/// Instructions are deduplicated through an ordered multiset, costing O(log n) full Instruction comparisons.
+class LegacyMultisetModule
+{
+    public:
+    Operand EmplaceInstruction(const spv::Op opCode, std::vector<Operand> operands)
+    {
+        Instruction inst{opCode, std::move(operands)};
+        auto it = m_SPIRVGraph.find(inst);
+        if (it == m_SPIRVGraph.end())
+        {
+            if (inst.HasResId())
+            {
+                inst.SetResId(m_ResId++);
+            }
+            it = m_SPIRVGraph.emplace(std::move(inst));
+        }
+        return Operand{&(*it)};
+    }
+
+    Operand EmplaceString(const std::string& str) { return Operand{&m_Strings.emplace_back(str)}; }
+
+    size_t Size() const { return m_SPIRVGraph.size(); }
+
+    private:
+    uint32_t m_ResId = 1;
+    std::list<LiteralString> m_Strings;
+    std::multiset<Instruction, InstructionComparator> m_SPIRVGraph;
+};
+
+/// Emit the Instructions the Graph API produces for a chain of operators, without going through the Graph API,
+/// so that any Module implementation exposing EmplaceInstruction can be measured.
+/// Types and small constants are shared between operators and so mostly hit the deduplication path.
+template <typename ModuleType>
+void EmitSyntheticInstructions(ModuleType& module, const uint32_t operatorCount)
+{
+    const auto import = module.EmplaceInstruction(spv::OpExtInstImport, {RESID, module.EmplaceString("TOSA.001000.1")});
+    auto previous = import;
+    for (uint32_t idx = 0; idx < operatorCount; ++idx)
+    {
+        const auto u32Type = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+        const auto i8Type = module.EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{8u}, Operand{0u}});
+        const auto rank = module.EmplaceInstruction(spv::OpConstant, {u32Type, RESID, Operand{4u}});
+        const auto arrayType = module.EmplaceInstruction(spv::OpTypeArray, {RESID, u32Type, rank});
+        std::vector<Operand> shapeOperands{arrayType, RESID};
+        for (const uint32_t dim : {1u, 1u + idx % 32u, 1u + (idx / 32u) % 32u, 8u * (1u + idx % 4u)})
+        {
+            shapeOperands.push_back(module.EmplaceInstruction(spv::OpConstant, {u32Type, RESID, Operand{dim}}));
+        }
+        const auto shape = module.EmplaceInstruction(spv::OpConstantComposite, std::move(shapeOperands));
+        const auto tensorType = module.EmplaceInstruction(spv::OpTypeTensorARM, {RESID, i8Type, rank, shape});
+        const auto attribute = module.EmplaceInstruction(spv::OpConstant, {u32Type, RESID, Operand{idx % 16u}});
+        previous = module.EmplaceInstruction(spv::OpExtInst,
+                                             {tensorType, RESID, import, Operand{idx % 8u}, attribute, previous});
+    }
+}
+
+} // namespace
+
+void RunModuleBenchmarks(const BenchmarkOptions& options)
+{
+    const auto operatorCount = options.m_OperatorCount;
+
+    size_t legacySize = 0;
+    const auto legacy = MeasureMilliseconds(
+        [&]() {
+            LegacyMultisetModule module;
+            EmitSyntheticInstructions(module, operatorCount);
+            legacySize = module.Size();
+        },
+        options.m_Iterations);
+    PrintResult("EmplaceInstruction", "multiset (legacy)", legacy);
+
+    size_t moduleSize = 0;
+    const auto hashed = MeasureMilliseconds(
+        [&]() {
+            Module module;
+            EmitSyntheticInstructions(module, operatorCount);
+            moduleSize = module.GetSpirvGraph().size();
+        },
+        options.m_Iterations);
+    PrintResult("EmplaceInstruction", "hash-consed", hashed);
+    PrintResult("EmplaceInstruction", "speedup", legacy / hashed, "x");
+
+    ModuleOptions arenaOptions;
+    arenaOptions.m_UseArena = true;
+    const auto arena = MeasureMilliseconds(
+        [&]() {
+            Module module{arenaOptions};
+            EmitSyntheticInstructions(module, operatorCount);
+        },
+        options.m_Iterations);
+    PrintResult("EmplaceInstruction", "hash-consed arena", arena);
+
+    ModuleOptions trackingOptions;
+    trackingOptions.m_TrackUses = true;
+    const auto tracking = MeasureMilliseconds(
+        [&]() {
+            Module module{trackingOptions};
+            EmitSyntheticInstructions(module, operatorCount);
+        },
+        options.m_Iterations);
+    PrintResult("EmplaceInstruction", "hash-consed tracking uses", tracking);
+
+    // Count the users of every Instruction, through the use index and by scanning the Module for each of them
+    Module trackedModule{trackingOptions};
+    EmitSyntheticInstructions(trackedModule, operatorCount);
+    const auto queriedDefinitions = std::min<size_t>(1000, trackedModule.GetSpirvGraph().size());
+    size_t indexedUses = 0;
+    const auto indexed = MeasureMilliseconds(
+        [&]() {
+            indexedUses = 0;
+            size_t queried = 0;
+            for (auto it = trackedModule.GetSpirvGraph().begin(); queried++ < queriedDefinitions; ++it)
+            {
+                indexedUses += trackedModule.GetUsers(*it).size();
+            }
+        },
+        options.m_Iterations);
+    size_t scannedUses = 0;
+    const auto scanned = MeasureMilliseconds(
+        [&]() {
+            scannedUses = 0;
+            size_t queried = 0;
+            for (auto it = trackedModule.GetSpirvGraph().begin(); queried++ < queriedDefinitions; ++it)
+            {
+                for (const auto& user : trackedModule.GetSpirvGraph())
+                {
+                    scannedUses += std::any_of(user.m_Operands.begin(), user.m_Operands.end(), [&](const Operand& op) {
+                        return op.GetType() == INSTRUCTION_POINTER && op.GetInstructionPtr() == &(*it);
+                    });
+                }
+            }
+        },
+        options.m_Iterations);
+    if (indexedUses != scannedUses)
+    {
+        throw std::runtime_error("Use index and Module scan disagree on the number of users");
+    }
+    PrintResult("GetUsers", "first 1000 definitions indexed", indexed);
+    PrintResult("GetUsers", "first 1000 definitions scanned", scanned);
+
+    for (const bool useArena : {false, true})
+    {
+        ModuleOptions moduleOptions;
+        moduleOptions.m_UseArena = useArena;
+        const auto allocationsBefore = GetAllocationCount();
+        {
+            Module module{moduleOptions};
+            EmitSyntheticInstructions(module, operatorCount);
+        }
+        PrintResult("EmplaceInstruction",
+                    useArena ? "arena allocations" : "default allocations",
+                    static_cast<double>(GetAllocationCount() - allocationsBefore),
+                    "");
+    }
+
+    if (legacySize != moduleSize)
+    {
+        throw std::runtime_error("Module implementations disagree on the number of unique Instructions");
+    }
+    PrintResult("EmplaceInstruction", "unique instructions", static_cast<double>(moduleSize), "");
+}
+
+} // namespace tfsc::benchmarks
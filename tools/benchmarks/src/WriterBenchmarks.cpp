@@ -0,0 +1,115 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <BenchmarkUtils.hpp>
+
+#include <BinarySink.hpp>
+#include <FrozenModule.hpp>
+#include <TosaForSpirvCodegen.hpp>
+
+namespace tfsc::benchmarks
+{
+
+using namespace tfsc::spirv;
+
+namespace
+{
+
+/// Number of Instructions in the Modules serialized by the writer benchmarks
+constexpr size_t WriterInstructionCount = 100000;
+
+/// Build a Module in which a single graph constant depends on a chain of WriterInstructionCount composites,
+/// the worst case for the depth of the writer's dependency walk.
+std::shared_ptr<Module> BuildDependencyChain()
+{
+    auto module = CreateModule(TOSAVersion::v1_0);
+    const auto u32Type = module->EmplaceInstruction(spv::OpTypeInt, {RESID, Operand{32u}, Operand{0u}});
+    auto previous = module->EmplaceInstruction(spv::OpConstant, {u32Type, RESID, Operand{0u}});
+    for (uint32_t idx = 0; idx < WriterInstructionCount; ++idx)
+    {
+        previous = module->EmplaceInstruction(spv::OpConstantComposite, {u32Type, RESID, previous, Operand{idx}});
+    }
+    module->EmplaceInstruction(spv::OpGraphConstantARM, {u32Type, RESID, previous});
+    return module;
+}
+
+void MeasureWriteToBinary(const std::string& variant, const std::shared_ptr<Module>& module, const unsigned iterations)
+{
+    const bool peakReset = ResetPeakRss();
+    const auto rssBefore = GetPeakRssKb();
+    const auto words = WriteToBinary(module).size();
+    const auto peakRss = std::max(GetPeakRssKb(), rssBefore) - rssBefore;
+
+    const auto milliseconds = MeasureMilliseconds([&]() { WriteToBinary(module); }, iterations);
+    PrintResult("WriteToBinary", variant + " instructions", static_cast<double>(module->GetSpirvGraph().size()), "");
+    PrintResult("WriteToBinary", variant + " words", static_cast<double>(words), "");
+    if (peakReset)
+    {
+        PrintResult("WriteToBinary", variant + " peak RSS growth", static_cast<double>(peakRss), "kB");
+    }
+    PrintResult("WriteToBinary", variant + " time", milliseconds);
+
+    BinaryWriterOptions compactOptions;
+    compactOptions.m_CompactResIds = true;
+    const auto compactBound = WriteToBinary(module, compactOptions)[3];
+    PrintResult("WriteToBinary", variant + " bound", static_cast<double>(WriteToBinary(module)[3]), "");
+    PrintResult("WriteToBinary", variant + " compact bound", static_cast<double>(compactBound), "");
+
+    const auto freezeMilliseconds = MeasureMilliseconds([&]() { module->Freeze(); }, iterations);
+    const auto frozen = module->Freeze();
+    const auto frozenMilliseconds = MeasureMilliseconds([&]() { WriteToBinary(frozen); }, iterations);
+    PrintResult("WriteToBinary", variant + " freeze time", freezeMilliseconds);
+    PrintResult("WriteToBinary", variant + " frozen time", frozenMilliseconds);
+
+    BinaryWriterOptions parallelOptions;
+    parallelOptions.m_ThreadCount = 0;
+    const auto parallelMilliseconds =
+        MeasureMilliseconds([&]() { WriteToBinary(module, parallelOptions); }, iterations);
+    PrintResult("WriteToBinary", variant + " parallel time", parallelMilliseconds);
+
+    // Stream the same binary through a sink that discards it, so only the writer's chunk is held in memory
+    size_t streamedWords = 0;
+    CallbackSink sink{[&](const uint32_t*, const std::size_t wordCount) { streamedWords += wordCount; }};
+    const bool streamPeakReset = ResetPeakRss();
+    const auto streamRssBefore = GetPeakRssKb();
+    WriteToBinary(module, sink);
+    const auto streamPeakRss = std::max(GetPeakRssKb(), streamRssBefore) - streamRssBefore;
+
+    const auto streamMilliseconds = MeasureMilliseconds([&]() { WriteToBinary(module, sink); }, iterations);
+    if (streamPeakReset)
+    {
+        PrintResult("WriteToBinary", variant + " streamed peak RSS growth", static_cast<double>(streamPeakRss), "kB");
+    }
+    PrintResult("WriteToBinary", variant + " streamed time", streamMilliseconds);
+}
+
+} // namespace
+
+void RunWriterBenchmarks(const BenchmarkOptions& options)
+{
+    // Scale the network from a small probe so the serialized Module holds about WriterInstructionCount Instructions
+    constexpr uint32_t probeOperators = 400;
+    const auto probeInstructions = BuildConvNetwork(probeOperators)->GetSpirvGraph().size();
+    const auto operatorCount =
+        static_cast<uint32_t>(WriterInstructionCount * probeOperators / std::max<size_t>(probeInstructions, 1));
+
+    MeasureWriteToBinary("network", BuildConvNetwork(operatorCount), options.m_Iterations);
+    MeasureWriteToBinary("dependency chain", BuildDependencyChain(), options.m_Iterations);
+
+    // The pass leaves nothing to remove when run again, so it is timed once
+    const auto network = BuildConvNetwork(operatorCount);
+    DeadInstructionReport report;
+    const auto dceMilliseconds = MeasureMilliseconds([&]() { report = EliminateDeadInstructions(network); }, 1);
+    PrintResult("EliminateDeadInstructions", "network time", dceMilliseconds);
+    PrintResult("EliminateDeadInstructions", "network removed instructions",
+                static_cast<double>(report.m_RemovedInstructions), "");
+    PrintResult("EliminateDeadInstructions", "network saved bytes", static_cast<double>(report.m_SavedBytes), "B");
+
+    const auto linkMilliseconds =
+        MeasureMilliseconds([&]() { LinkModules(CreateModule(TOSAVersion::v1_0), network); }, options.m_Iterations);
+    PrintResult("LinkModules", "network into empty Module time", linkMilliseconds);
+}
+
+} // namespace tfsc::benchmarks
@@ -0,0 +1,86 @@
+//
+// Copyright © 2025 Arm Ltd and Contributors. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <BenchmarkUtils.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace tfsc::benchmarks;
+
+namespace
+{
+
+struct Benchmark
+{
+    const char* m_Name;
+    void (*m_Function)(const BenchmarkOptions&);
+};
+
+const std::vector<Benchmark>& GetBenchmarks()
+{
+    static const std::vector<Benchmark> benchmarks{
+        {"module", RunModuleBenchmarks},
+        {"graph", RunGraphBenchmarks},
+        {"writer", RunWriterBenchmarks},
+    };
+    return benchmarks;
+}
+
+void PrintUsage(const char* executable)
+{
+    std::cout << "Usage: " << executable << " [--operators N] [--iterations N] [benchmark...]" << std::endl;
+    std::cout << "Available benchmarks:";
+    for (const auto& benchmark : GetBenchmarks())
+    {
+        std::cout << " " << benchmark.m_Name;
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    BenchmarkOptions options;
+    std::vector<std::string> selected;
+
+    try
+    {
+        for (int idx = 1; idx < argc; ++idx)
+        {
+            const std::string argument = argv[idx];
+            if (argument == "-h" || argument == "--help")
+            {
+                PrintUsage(argv[0]);
+                return 0;
+            }
+            if ((argument == "--operators" || argument == "--iterations") && idx + 1 < argc)
+            {
+                const auto value = static_cast<uint32_t>(std::stoul(argv[++idx]));
+                (argument == "--operators" ? options.m_OperatorCount : options.m_Iterations) = value;
+                continue;
+            }
+            selected.push_back(argument);
+        }
+
+        for (const auto& benchmark : GetBenchmarks())
+        {
+            if (selected.empty() || std::find(selected.begin(), selected.end(), benchmark.m_Name) != selected.end())
+            {
+                benchmark.m_Function(options);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "tfsc-benchmarks: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
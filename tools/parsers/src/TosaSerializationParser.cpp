@@ -234,7 +234,16 @@ std::vector<uint32_t> TosaSerializationParser::GenerateSPIRV(std::string graphNa
 std::shared_ptr<spirv::Module> TosaSerializationParser::GenerateSPIRVModule(const std::string graphName)
 {
     auto module = CreateModule(m_Version);
-    auto graph = Graph(module, graphName);
+
+    // Pre-size the Module from the size of the block
+    GraphCapacity capacity;
+    capacity.m_OperatorCount = m_Block->GetOperators().size();
+    capacity.m_TensorCount = m_Block->GetTensors().size();
+    for (const auto& op : m_Block->GetOperators())
+    {
+        capacity.m_ConstantCount += IsConstOp(op.get()) ? 1 : 0;
+    }
+    auto graph = Graph(module, graphName, capacity);
 
     unsigned int bindingId = 0;
 
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <memory>
 #include <queue>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -40,13 +41,9 @@ std::vector<TosaOperator> Spirv2operators(const std::shared_ptr<tfsc::spirv::Mod
 /// Returns the actual ResId number from a tfsc::tosa::ResId instance (masked spirv::Instruction pointer)
 inline uint32_t GetResIdNumber(const tfsc::tosa::ResId& resId)
 {
-    if (resId->m_Operands.size() > 0 && resId->m_Operands[0].m_Type == tfsc::spirv::RES_ID)
+    if (resId->HasResId() && resId->m_ResIdPosition <= 1)
     {
-        return resId->m_Operands[0].m_LiteralWord;
-    }
-    if (resId->m_Operands.size() > 1 && resId->m_Operands[1].m_Type == tfsc::spirv::RES_ID)
-    {
-        return resId->m_Operands[1].m_LiteralWord;
+        return resId->GetResId();
     }
     throw std::runtime_error{"GetResIdNumber: Did not find valid RES_ID number"};
 };
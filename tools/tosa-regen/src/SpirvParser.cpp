@@ -14,7 +14,7 @@ tosa::DataType GetDataTypeFromInstruction(const spirv::Instruction& typeInstruct
     // Based on SPIRVDefinitions.cpp inverse of the function 'tfsc::spirv::CreateDataType'
     if (typeInstruction.GetOpCode() == spv::Op::OpTypeInt)
     {
-        const auto bitWidth = typeInstruction.m_Operands[1].m_LiteralWord;
+        const auto bitWidth = typeInstruction.m_Operands[1].GetLiteralWord();
         switch (bitWidth)
         {
             case 8: return tosa::DataType::uint8_t;
@@ -26,10 +26,10 @@ tosa::DataType GetDataTypeFromInstruction(const spirv::Instruction& typeInstruct
     }
     else if (typeInstruction.GetOpCode() == spv::Op::OpTypeFloat)
     {
-        const auto bitWidth = typeInstruction.m_Operands[1].m_LiteralWord;
+        const auto bitWidth = typeInstruction.m_Operands[1].GetLiteralWord();
         if (typeInstruction.m_Operands.size() == 3)
         {
-            const auto fpEncoding = typeInstruction.m_Operands[2].m_LiteralWord;
+            const auto fpEncoding = typeInstruction.m_Operands[2].GetLiteralWord();
             if (bitWidth == 16 && fpEncoding == 0)
             {
                 return tosa::DataType::bfloat16_t;
@@ -60,9 +60,9 @@ std::vector<uint32_t> GetTensorShapeFromInstruction(const spirv::Instruction& sh
 {
     if (shapeInstruction.GetOpCode() == spv::Op::OpConstantCompositeReplicateEXT)
     {
-        const uint32_t value = shapeInstruction.m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord;
-        const auto array = shapeInstruction.m_Operands[0].m_InstructionPtr;
-        const uint32_t size = array->m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord;
+        const uint32_t value = shapeInstruction.m_Operands[2].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
+        const auto array = shapeInstruction.m_Operands[0].GetInstructionPtr();
+        const uint32_t size = array->m_Operands[2].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
         return std::vector<uint32_t>(size, value);
     }
     else if (shapeInstruction.GetOpCode() == spv::Op::OpConstantComposite)
@@ -70,8 +70,8 @@ std::vector<uint32_t> GetTensorShapeFromInstruction(const spirv::Instruction& sh
         std::vector<uint32_t> shape;
         for (size_t idx = 2; idx < shapeInstruction.m_Operands.size(); ++idx)
         {
-            const auto constituentInstruction = shapeInstruction.m_Operands[idx].m_InstructionPtr;
-            shape.push_back(constituentInstruction->m_Operands[2].m_LiteralWord);
+            const auto constituentInstruction = shapeInstruction.m_Operands[idx].GetInstructionPtr();
+            shape.push_back(constituentInstruction->m_Operands[2].GetLiteralWord());
         }
         return shape;
     }
@@ -88,10 +88,10 @@ tosa::Tensor GetTensorFromInstruction(const spirv::Instruction& tensorInstructio
         throw std::invalid_argument{"GetTensorFromInstruction: must supply OpTypeTensorArm instruction"};
     }
 
-    const auto typeInstruction = tensorInstruction.m_Operands[1].m_InstructionPtr;
+    const auto typeInstruction = tensorInstruction.m_Operands[1].GetInstructionPtr();
     const tosa::DataType type = GetDataTypeFromInstruction(*typeInstruction);
 
-    const auto shapeInstruction = tensorInstruction.m_Operands[3].m_InstructionPtr;
+    const auto shapeInstruction = tensorInstruction.m_Operands[3].GetInstructionPtr();
     const std::vector<uint32_t> shape = GetTensorShapeFromInstruction(*shapeInstruction);
 
     return tosa::Tensor{type, shape};
@@ -107,13 +107,13 @@ tosa::Attribute GetAttributeFromInstruction(const spirv::Instruction& attributeI
     }
     else if (attributeInstruction.GetOpCode() == spv::Op::OpConstant)
     {
-        const auto dataType = GetDataTypeFromInstruction(*attributeInstruction.m_Operands[0].m_InstructionPtr);
+        const auto dataType = GetDataTypeFromInstruction(*attributeInstruction.m_Operands[0].GetInstructionPtr());
         std::vector<uint32_t> values;
-        values.push_back(attributeInstruction.m_Operands[2].m_LiteralWord);
+        values.push_back(attributeInstruction.m_Operands[2].GetLiteralWord());
 
         if (dataType == tosa::DataType::int48_t)
         {
-            values.push_back(attributeInstruction.m_Operands[3].m_LiteralWord);
+            values.push_back(attributeInstruction.m_Operands[3].GetLiteralWord());
         }
 
         return tosa::Attribute{values, dataType, {1}};
@@ -122,7 +122,7 @@ tosa::Attribute GetAttributeFromInstruction(const spirv::Instruction& attributeI
              attributeInstruction.GetOpCode() == spv::Op::OpConstantComposite ||
              attributeInstruction.GetOpCode() == spv::Op::OpConstantCompositeReplicateEXT)
     {
-        const auto tensor = GetTensorFromInstruction(*attributeInstruction.m_Operands[0].m_InstructionPtr);
+        const auto tensor = GetTensorFromInstruction(*attributeInstruction.m_Operands[0].GetInstructionPtr());
         std::vector<uint32_t> data;
 
         if (attributeInstruction.GetOpCode() == spv::Op::OpConstantNull)
@@ -131,20 +131,20 @@ tosa::Attribute GetAttributeFromInstruction(const spirv::Instruction& attributeI
         }
         else if (attributeInstruction.GetOpCode() == spv::Op::OpConstantCompositeReplicateEXT)
         {
-            const auto valueInstruction = attributeInstruction.m_Operands[2].m_InstructionPtr;
+            const auto valueInstruction = attributeInstruction.m_Operands[2].GetInstructionPtr();
             data.insert(data.end(),
                         static_cast<size_t>(tensor.GetNumElements()),
-                        valueInstruction->m_Operands[2].m_LiteralWord);
+                        valueInstruction->m_Operands[2].GetLiteralWord());
         }
         else
         {
             for (size_t idx = 2; idx < attributeInstruction.m_Operands.size(); ++idx)
             {
-                const auto valueInstruction = attributeInstruction.m_Operands[idx].m_InstructionPtr;
-                data.push_back(valueInstruction->m_Operands[2].m_LiteralWord);
+                const auto valueInstruction = attributeInstruction.m_Operands[idx].GetInstructionPtr();
+                data.push_back(valueInstruction->m_Operands[2].GetLiteralWord());
                 if (tensor.GetDataType() == tosa::DataType::int48_t)
                 {
-                    data.push_back(valueInstruction->m_Operands[3].m_LiteralWord);
+                    data.push_back(valueInstruction->m_Operands[3].GetLiteralWord());
                 }
             }
         }
@@ -172,29 +172,29 @@ TosaOperator GetTosaOperator(const spirv::Instruction& instruction)
 
     TosaOperator tosaOp;
 
-    tosaOp.op = GetOperatorEnum(static_cast<TOSAInstructions>(instruction.m_Operands[3].m_LiteralWord));
+    tosaOp.op = GetOperatorEnum(static_cast<TOSAInstructions>(instruction.m_Operands[3].GetLiteralWord()));
 
     const tosa::OperatorDefinition& tosaOpDefinition = tosa::GetOperatorDefinition(tosaOp.op);
 
     // Processing output
-    if (instruction.m_Operands[0].m_Type != spirv::INSTRUCTION_POINTER)
+    if (instruction.m_Operands[0].GetType() != spirv::INSTRUCTION_POINTER)
     {
         throw std::invalid_argument{"GetTosaOperator: Invalid output tensor in Instruction operands"};
     }
-    const auto outputInstruction = instruction.m_Operands[0].m_InstructionPtr;
+    const auto outputInstruction = instruction.m_Operands[0].GetInstructionPtr();
     if (outputInstruction->GetOpCode() == spv::Op::OpTypeStruct)
     {
         for (size_t idx = 1; idx < outputInstruction->m_Operands.size(); ++idx)
         {
-            const auto& outputTensor = GetTensorFromInstruction(*outputInstruction->m_Operands[idx].m_InstructionPtr);
+            const auto& outputTensor = GetTensorFromInstruction(*outputInstruction->m_Operands[idx].GetInstructionPtr());
             tosaOp.outputs.push_back(
-                TosaOutput{outputTensor, instruction.m_Operands[1].m_LiteralWord, static_cast<uint8_t>(idx - 1)});
+                TosaOutput{outputTensor, instruction.m_Operands[1].GetLiteralWord(), static_cast<uint8_t>(idx - 1)});
         }
     }
     else
     {
         const auto& outputTensor = GetTensorFromInstruction(*outputInstruction);
-        tosaOp.outputs.push_back(TosaOutput{outputTensor, instruction.m_Operands[1].m_LiteralWord, 0});
+        tosaOp.outputs.push_back(TosaOutput{outputTensor, instruction.m_Operands[1].GetLiteralWord(), 0});
     }
     //  Checking outputs are correct
     if (tosaOp.outputs.size() != tosaOpDefinition.m_OutputSize)
@@ -212,7 +212,7 @@ TosaOperator GetTosaOperator(const spirv::Instruction& instruction)
     size_t lastAttributeIdx = 0;
     for (size_t idx = 4; idx < instruction.m_Operands.size(); ++idx)
     {
-        const auto currentInst = instruction.m_Operands[idx].m_InstructionPtr;
+        const auto currentInst = instruction.m_Operands[idx].GetInstructionPtr();
 
         if (lastAttributeIdx < tosaOpDefinition.m_AttributeSize)
         {
@@ -235,29 +235,29 @@ TosaOperator GetTosaOperator(const spirv::Instruction& instruction)
                 currentInst->GetOpCode() == spv::Op::OpCompositeExtract)
             {
                 // OpGraphInputARM Input Tensor format: OpTypeTensorARM, RES_ID, OpConstant (input index)
-                const auto& inputTensor = GetTensorFromInstruction(*currentInst->m_Operands[0].m_InstructionPtr);
-                uint32_t tensorId = currentInst->m_Operands[1].m_LiteralWord;
+                const auto& inputTensor = GetTensorFromInstruction(*currentInst->m_Operands[0].GetInstructionPtr());
+                uint32_t tensorId = currentInst->m_Operands[1].GetLiteralWord();
                 uint8_t tensorIdx = 0;
                 if (currentInst->GetOpCode() == spv::Op::OpCompositeExtract)
                 {
-                    tensorId = currentInst->m_Operands[2].m_InstructionPtr->m_Operands[1].m_LiteralWord;
-                    tensorIdx = currentInst->m_Operands[3].m_LiteralWord;
+                    tensorId = currentInst->m_Operands[2].GetInstructionPtr()->m_Operands[1].GetLiteralWord();
+                    tensorIdx = currentInst->m_Operands[3].GetLiteralWord();
                 }
                 uint32_t bindingId = 0;
                 if (currentInst->GetOpCode() == spv::Op::OpGraphInputARM)
                 {
-                    bindingId = currentInst->m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord;
+                    bindingId = currentInst->m_Operands[2].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
                 }
                 tosaOp.inputs.push_back(TosaInput{inputTensor, TosaInputType::Dynamic, tensorId, tensorIdx, bindingId});
             }
             else if (currentInst->GetOpCode() == spv::Op::OpGraphConstantARM)
             {
-                const auto& graphConstTensor = GetTensorFromInstruction(*currentInst->m_Operands[0].m_InstructionPtr);
+                const auto& graphConstTensor = GetTensorFromInstruction(*currentInst->m_Operands[0].GetInstructionPtr());
                 tosaOp.inputs.push_back(TosaInput{graphConstTensor,
                                                   TosaInputType::GraphConstant,
-                                                  currentInst->m_Operands[1].m_LiteralWord,
+                                                  currentInst->m_Operands[1].GetLiteralWord(),
                                                   0,
-                                                  currentInst->m_Operands[2].m_LiteralWord});
+                                                  currentInst->m_Operands[2].GetLiteralWord()});
             }
             else
             {
@@ -266,7 +266,7 @@ TosaOperator GetTosaOperator(const spirv::Instruction& instruction)
                     const auto& tensorConstAttribute = GetAttributeFromInstruction(*currentInst);
                     tosaOp.inputs.push_back(TosaInput{tensorConstAttribute,
                                                       TosaInputType::TensorConstant,
-                                                      currentInst->m_Operands[1].m_LiteralWord,
+                                                      currentInst->m_Operands[1].GetLiteralWord(),
                                                       0});
                 }
                 catch (std::invalid_argument& error)
@@ -473,7 +473,7 @@ GetTosaSerializationHandler(const std::shared_ptr<tfsc::spirv::Module>& module,
     const auto& inputOps = module->GetInstructionsOfType(spv::Op::OpGraphInputARM);
     for (auto instructionIt = inputOps.first; instructionIt != inputOps.second; ++instructionIt)
     {
-        const uint32_t tensorId = instructionIt->m_Operands[1].m_LiteralWord;
+        const uint32_t tensorId = instructionIt->m_Operands[1].GetLiteralWord();
         graphInputNames.push_back(GetTosaSerializationTensorName(tensorId, 0, tensorNameMap, "tensor_"));
     }
     std::sort(graphInputNames.begin(), graphInputNames.end());
@@ -482,17 +482,17 @@ GetTosaSerializationHandler(const std::shared_ptr<tfsc::spirv::Module>& module,
     const auto& outputOps = module->GetInstructionsOfType(spv::Op::OpGraphSetOutputARM);
     for (auto instructionIt = outputOps.first; instructionIt != outputOps.second; ++instructionIt)
     {
-        const auto& outputInstruction = instructionIt->m_Operands[0].m_InstructionPtr;
+        const auto& outputInstruction = instructionIt->m_Operands[0].GetInstructionPtr();
         uint32_t tensorId = 0;
         uint32_t tensorIdx = 0;
         if (outputInstruction->m_Opcode == spv::Op::OpExtInst)
         {
-            tensorId = outputInstruction->m_Operands[1].m_LiteralWord;
+            tensorId = outputInstruction->m_Operands[1].GetLiteralWord();
         }
         else if (outputInstruction->m_Opcode == spv::Op::OpCompositeExtract)
         {
-            tensorId = outputInstruction->m_Operands[2].m_InstructionPtr->m_Operands[1].m_LiteralWord;
-            tensorIdx = outputInstruction->m_Operands[3].m_LiteralWord;
+            tensorId = outputInstruction->m_Operands[2].GetInstructionPtr()->m_Operands[1].GetLiteralWord();
+            tensorIdx = outputInstruction->m_Operands[3].GetLiteralWord();
         }
         graphOutputNames.push_back(GetTosaSerializationTensorName(tensorId, tensorIdx, tensorNameMap, "tensor_"));
     }
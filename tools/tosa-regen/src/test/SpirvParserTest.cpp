@@ -45,7 +45,7 @@ bool GetTosaOperatorTest(TosaOperator op)
 
     const auto output = operatorId[0];
     const TosaOperator generatedOp = GetTosaOperator(
-        output->GetOpCode() == spv::OpCompositeExtract ? *output->m_Operands[2].m_InstructionPtr : *output);
+        output->GetOpCode() == spv::OpCompositeExtract ? *output->m_Operands[2].GetInstructionPtr() : *output);
 
     return CompareTosaOperatorData(op, generatedOp);
 }
@@ -59,26 +59,26 @@ TEST(Spirv2TosaTest, GetDataTypeFromInstructionTest)
         spv::Op::OpTypeInt,
         {tfsc::spirv::Operand{}, tfsc::spirv::Operand{8u}, tfsc::spirv::Operand{0u}}};
     EXPECT_EQ(GetDataTypeFromInstruction(intInstruction), tfsc::tosa::DataType::uint8_t);
-    intInstruction.m_Operands[1].m_LiteralWord = 16;
+    intInstruction.m_Operands[1] = tfsc::spirv::Operand{16u};
     EXPECT_EQ(GetDataTypeFromInstruction(intInstruction), tfsc::tosa::DataType::uint16_t);
-    intInstruction.m_Operands[1].m_LiteralWord = 32;
+    intInstruction.m_Operands[1] = tfsc::spirv::Operand{32u};
     EXPECT_EQ(GetDataTypeFromInstruction(intInstruction), tfsc::tosa::DataType::uint32_t);
-    intInstruction.m_Operands[1].m_LiteralWord = 64;
+    intInstruction.m_Operands[1] = tfsc::spirv::Operand{64u};
     EXPECT_EQ(GetDataTypeFromInstruction(intInstruction), tfsc::tosa::DataType::int48_t);
-    intInstruction.m_Operands[1].m_LiteralWord = 65;
+    intInstruction.m_Operands[1] = tfsc::spirv::Operand{65u};
     EXPECT_THROW(GetDataTypeFromInstruction(intInstruction), std::invalid_argument);
 
     tfsc::spirv::Instruction floatInstruction{spv::Op::OpTypeFloat,
                                                     {tfsc::spirv::Operand{}, tfsc::spirv::Operand{16u}}};
     EXPECT_EQ(GetDataTypeFromInstruction(floatInstruction), tfsc::tosa::DataType::float16_t);
-    floatInstruction.m_Operands[1].m_LiteralWord = 32;
+    floatInstruction.m_Operands[1] = tfsc::spirv::Operand{32u};
     EXPECT_EQ(GetDataTypeFromInstruction(floatInstruction), tfsc::tosa::DataType::float32_t);
-    floatInstruction.m_Operands[1].m_LiteralWord = 64;
+    floatInstruction.m_Operands[1] = tfsc::spirv::Operand{64u};
     EXPECT_THROW(GetDataTypeFromInstruction(floatInstruction), std::invalid_argument);
-    floatInstruction.m_Operands[1].m_LiteralWord = 16;
+    floatInstruction.m_Operands[1] = tfsc::spirv::Operand{16u};
     floatInstruction.m_Operands.emplace_back(0u);
     EXPECT_EQ(GetDataTypeFromInstruction(floatInstruction), tfsc::tosa::DataType::bfloat16_t);
-    floatInstruction.m_Operands[2].m_LiteralWord = 1u;
+    floatInstruction.m_Operands[2] = tfsc::spirv::Operand{1u};
     EXPECT_THROW(GetDataTypeFromInstruction(floatInstruction), std::invalid_argument);
 
     tfsc::spirv::Instruction incorrectInstruction{
@@ -334,7 +334,7 @@ TEST(Spirv2TosaTest, GetTosaOperatorErrorTest2)
     EXPECT_THROW(GetTosaOperator(instruction), std::invalid_argument);
 
     // Fixing data type, still invalid
-    typeInstruction.m_Operands[1].m_LiteralWord = 32u;
+    typeInstruction.m_Operands[1] = tfsc::spirv::Operand{32u};
     EXPECT_THROW(GetTosaOperator(instruction), std::invalid_argument);
 
     // Fixing tensor shape, still invalid
@@ -354,7 +354,7 @@ TEST(Spirv2TosaTest, GetTosaOperatorErrorTest2)
                                                     {tfsc::spirv::Operand{&outputTensor},
                                                      tfsc::spirv::Operand{0u},
                                                      tfsc::spirv::Operand{&inputBindingId}}};
-    instruction.m_Operands[4].m_InstructionPtr = &validInstruction;
+    instruction.m_Operands[4] = tfsc::spirv::Operand{&validInstruction};
     instruction.m_Operands.push_back(tfsc::spirv::Operand{&validInstruction});
     EXPECT_NO_THROW(GetTosaOperator(instruction));
 }
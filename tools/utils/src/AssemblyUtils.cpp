@@ -73,7 +73,7 @@ using tfsc::spirv::Module;
 using tfsc::spirv::Operand;
 using ResIdMap = std::unordered_map<std::string, Operand>;
 
-std::vector<Operand> ParseOperand(const std::string& token, ResIdMap& resIdMap)
+std::vector<Operand> ParseOperand(const std::string& token, ResIdMap& resIdMap, Module& module)
 {
     if (token.empty())
     {
@@ -93,7 +93,7 @@ std::vector<Operand> ParseOperand(const std::string& token, ResIdMap& resIdMap)
             throw std::invalid_argument("Mismatched quotes in operand: " + token);
         }
         const std::string inner = token.substr(1, token.size() - 2);
-        return {Operand(inner)};
+        return {module.EmplaceString(inner)};
     }
 
     // Keep only chars that can appear in a numeric literal.
@@ -158,7 +158,7 @@ std::vector<Operand> ParseOperand(const std::string& token, ResIdMap& resIdMap)
     }
 }
 
-std::vector<Operand> ParseTosaInstruction(std::istringstream& line, ResIdMap& resIdMap)
+std::vector<Operand> ParseTosaInstruction(std::istringstream& line, ResIdMap& resIdMap, Module& module)
 {
     std::string token;
     std::vector<Operand> operands;
@@ -174,14 +174,14 @@ std::vector<Operand> ParseTosaInstruction(std::istringstream& line, ResIdMap& re
 
     while (line >> token)
     {
-        const auto vals = ParseOperand(token, resIdMap);
+        const auto vals = ParseOperand(token, resIdMap, module);
         operands.insert(operands.end(), vals.begin(), vals.end());
     }
 
     return operands;
 }
 
-std::vector<Operand> ParseOp(spv::Op op, std::istringstream& line, ResIdMap& resIdMap)
+std::vector<Operand> ParseOp(spv::Op op, std::istringstream& line, ResIdMap& resIdMap, Module& module)
 {
     std::string token;
     std::vector<Operand> operands;
@@ -191,12 +191,12 @@ std::vector<Operand> ParseOp(spv::Op op, std::istringstream& line, ResIdMap& res
     {
         case spv::Op::OpExtInst:
         {
-            return ParseTosaInstruction(line, resIdMap);
+            return ParseTosaInstruction(line, resIdMap, module);
         }
         case spv::Op::OpDecorate:
         {
             line >> token;
-            auto vals = ParseOperand(token, resIdMap);
+            auto vals = ParseOperand(token, resIdMap, module);
             operands.insert(operands.end(), vals.begin(), vals.end());
             line >> token;
             if (token == "DescriptorSet")
@@ -208,7 +208,7 @@ std::vector<Operand> ParseOp(spv::Op op, std::istringstream& line, ResIdMap& res
                 operands.emplace_back(spv::DecorationBinding);
             }
             line >> token;
-            vals = ParseOperand(token, resIdMap);
+            vals = ParseOperand(token, resIdMap, module);
             operands.insert(operands.end(), vals.begin(), vals.end());
             return operands;
         }
@@ -228,14 +228,14 @@ std::vector<Operand> ParseOp(spv::Op op, std::istringstream& line, ResIdMap& res
             operands.emplace_back(spv::StorageClassUniformConstant);
             line >> token;
             line >> token;
-            const auto vals = ParseOperand(token, resIdMap);
+            const auto vals = ParseOperand(token, resIdMap, module);
             operands.insert(operands.end(), vals.begin(), vals.end());
             return operands;
         }
         case spv::Op::OpVariable:
         {
             line >> token;
-            const auto vals = ParseOperand(token, resIdMap);
+            const auto vals = ParseOperand(token, resIdMap, module);
             operands.insert(operands.end(), vals.begin(), vals.end());
             operands.emplace_back(spv::StorageClassUniformConstant);
             return operands;
@@ -247,7 +247,7 @@ std::vector<Operand> ParseOp(spv::Op op, std::istringstream& line, ResIdMap& res
 
     while (line >> token)
     {
-        const auto vals = ParseOperand(token, resIdMap);
+        const auto vals = ParseOperand(token, resIdMap, module);
         operands.insert(operands.end(), vals.begin(), vals.end());
     }
 
@@ -290,7 +290,7 @@ void ParseSpirvTextImpl(const std::string& text, Module& module, ResIdMap& resId
                         // wait for the second pass
                         break;
                     }
-                    operands = ParseOp(opcode, iss, resIdMap);
+                    operands = ParseOp(opcode, iss, resIdMap, module);
                 }
                 catch (const std::invalid_argument& ex)
                 {
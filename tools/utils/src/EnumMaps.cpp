@@ -407,12 +407,5 @@ std::string OpToString(const spv::Op op)
 
 unsigned int GetResId(const tfsc::spirv::Instruction& instruction)
 {
-    for (const auto& operand : instruction.m_Operands)
-    {
-        if (operand.m_Type == tfsc::spirv::RES_ID)
-        {
-            return operand.m_LiteralWord;
-        }
-    }
-    return 0;
+    return instruction.GetResId();
 }
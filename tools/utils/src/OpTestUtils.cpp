@@ -61,11 +61,11 @@ void CheckModule(const std::shared_ptr<spirv::Module>& module,
     EXPECT_TRUE(opInstruction != module->GetSpirvGraph().end() && opInstruction->m_Operands.size() >= 4);
 
     const auto& opCodeInstruction = opInstruction->m_Operands[3];
-    EXPECT_TRUE(opCodeInstruction.m_Type == spirv::LITERAL_WORD &&
-                static_cast<TOSAInstructions>(opCodeInstruction.m_LiteralWord) == op);
+    EXPECT_TRUE(opCodeInstruction.GetType() == spirv::LITERAL_WORD &&
+                static_cast<TOSAInstructions>(opCodeInstruction.GetLiteralWord()) == op);
 
-    EXPECT_EQ(opInstruction->m_Operands[0].m_Type, spirv::INSTRUCTION_POINTER);
-    const auto& outputInstruction = opInstruction->m_Operands[0].m_InstructionPtr;
+    EXPECT_EQ(opInstruction->m_Operands[0].GetType(), spirv::INSTRUCTION_POINTER);
+    const auto& outputInstruction = opInstruction->m_Operands[0].GetInstructionPtr();
 
     EXPECT_TRUE(outputs.size() == 1 || outputs.size() == 2);
     if (outputs.size() == 1)
@@ -80,12 +80,12 @@ void CheckModule(const std::shared_ptr<spirv::Module>& module,
         EXPECT_EQ(outputInstruction->GetOpCode(), spv::Op::OpTypeStruct);
         const auto& output1 = outputInstruction->m_Operands[1];
         const auto& output2 = outputInstruction->m_Operands[2];
-        EXPECT_TRUE(output1.m_Type == spirv::INSTRUCTION_POINTER && output2.m_Type == spirv::INSTRUCTION_POINTER);
-        CheckTensorType(output1.m_InstructionPtr,
+        EXPECT_TRUE(output1.GetType() == spirv::INSTRUCTION_POINTER && output2.GetType() == spirv::INSTRUCTION_POINTER);
+        CheckTensorType(output1.GetInstructionPtr(),
                         outputs[0].GetDataType(),
                         outputs[0].GetTensorShape().size(),
                         outputs[0].GetTensorShape());
-        CheckTensorType(output2.m_InstructionPtr,
+        CheckTensorType(output2.GetInstructionPtr(),
                         outputs[1].GetDataType(),
                         outputs[1].GetTensorShape().size(),
                         outputs[1].GetTensorShape());
@@ -95,22 +95,22 @@ void CheckModule(const std::shared_ptr<spirv::Module>& module,
     EXPECT_EQ(opInstruction->m_Operands.size() - 4, (inputs.size() + attributes.size()));
     for (const auto& attribute : attributes)
     {
-        EXPECT_EQ(opInstruction->m_Operands[opIdx].m_Type, spirv::INSTRUCTION_POINTER);
-        const auto& currentInst = opInstruction->m_Operands[opIdx++].m_InstructionPtr;
+        EXPECT_EQ(opInstruction->m_Operands[opIdx].GetType(), spirv::INSTRUCTION_POINTER);
+        const auto& currentInst = opInstruction->m_Operands[opIdx++].GetInstructionPtr();
 
         CheckAttributeOperand(currentInst, attribute);
     }
     for (const auto& input : inputs)
     {
-        EXPECT_EQ(opInstruction->m_Operands[opIdx].m_Type, spirv::INSTRUCTION_POINTER);
-        const auto& currentInst = opInstruction->m_Operands[opIdx++].m_InstructionPtr;
+        EXPECT_EQ(opInstruction->m_Operands[opIdx].GetType(), spirv::INSTRUCTION_POINTER);
+        const auto& currentInst = opInstruction->m_Operands[opIdx++].GetInstructionPtr();
 
         if (currentInst->GetOpCode() == spv::Op::OpGraphInputARM || currentInst->GetOpCode() == spv::Op::OpExtInst ||
             currentInst->GetOpCode() == spv::Op::OpGraphConstantARM)
         {
             EXPECT_TRUE(currentInst->m_Operands.size() > 0 &&
-                        currentInst->m_Operands[0].m_Type == spirv::INSTRUCTION_POINTER);
-            const auto& inputInstruction = currentInst->m_Operands[0].m_InstructionPtr;
+                        currentInst->m_Operands[0].GetType() == spirv::INSTRUCTION_POINTER);
+            const auto& inputInstruction = currentInst->m_Operands[0].GetInstructionPtr();
             CheckTensorType(inputInstruction,
                             input.GetTensor().GetDataType(),
                             input.GetTensor().GetTensorShape().size(),
@@ -24,9 +24,9 @@ std::string ResIdToString(const tfsc::spirv::Instruction& instruction)
     std::string resId{};
     for (const auto& operand : instruction.m_Operands)
     {
-        if (operand.m_Type == tfsc::spirv::RES_ID)
+        if (operand.GetType() == tfsc::spirv::RES_ID)
         {
-            resId = "%" + std::to_string(operand.m_LiteralWord);
+            resId = "%" + std::to_string(operand.GetLiteralWord());
             break;
         }
     }
@@ -36,12 +36,12 @@ std::string ResIdToString(const tfsc::spirv::Instruction& instruction)
 std::string OperandToString(const tfsc::spirv::Operand& operand)
 {
     std::string operandString;
-    switch (operand.m_Type)
+    switch (operand.GetType())
     {
-        case tfsc::spirv::INSTRUCTION_POINTER: operandString = ResIdToString(*operand.m_InstructionPtr); break;
+        case tfsc::spirv::INSTRUCTION_POINTER: operandString = ResIdToString(*operand.GetInstructionPtr()); break;
         case tfsc::spirv::RES_ID: break;
-        case tfsc::spirv::LITERAL_WORD: operandString = std::to_string(operand.m_LiteralWord); break;
-        case tfsc::spirv::LITERAL_STRING: operandString = *operand.m_LiteralStr; break;
+        case tfsc::spirv::LITERAL_WORD: operandString = std::to_string(operand.GetLiteralWord()); break;
+        case tfsc::spirv::LITERAL_STRING: operandString = operand.GetLiteralStr(); break;
         default: throw std::runtime_error("Invalid operand type");
     }
     return operandString;
@@ -56,25 +56,25 @@ void CheckDataType(const spirv::Instruction* instr, tosa::DataType expectedDataT
             case tosa::DataType::int4_t:
             case tosa::DataType::int8_t:
             case tosa::DataType::uint8_t:
-                return instruction->m_Opcode == spv::OpTypeInt && instruction->m_Operands[1].m_LiteralWord == 8 &&
-                       instruction->m_Operands[2].m_LiteralWord == 0;
+                return instruction->m_Opcode == spv::OpTypeInt && instruction->m_Operands[1].GetLiteralWord() == 8 &&
+                       instruction->m_Operands[2].GetLiteralWord() == 0;
             case tosa::DataType::int16_t:
             case tosa::DataType::uint16_t:
-                return instruction->m_Opcode == spv::OpTypeInt && instruction->m_Operands[1].m_LiteralWord == 16 &&
-                       instruction->m_Operands[2].m_LiteralWord == 0;
+                return instruction->m_Opcode == spv::OpTypeInt && instruction->m_Operands[1].GetLiteralWord() == 16 &&
+                       instruction->m_Operands[2].GetLiteralWord() == 0;
             case tosa::DataType::int32_t:
             case tosa::DataType::uint32_t:
-                return instruction->m_Opcode == spv::OpTypeInt && instruction->m_Operands[1].m_LiteralWord == 32 &&
-                       instruction->m_Operands[2].m_LiteralWord == 0;
+                return instruction->m_Opcode == spv::OpTypeInt && instruction->m_Operands[1].GetLiteralWord() == 32 &&
+                       instruction->m_Operands[2].GetLiteralWord() == 0;
             case tosa::DataType::int48_t:
-                return instruction->m_Opcode == spv::OpTypeInt && instruction->m_Operands[1].m_LiteralWord == 64 &&
-                       instruction->m_Operands[2].m_LiteralWord == 0;
+                return instruction->m_Opcode == spv::OpTypeInt && instruction->m_Operands[1].GetLiteralWord() == 64 &&
+                       instruction->m_Operands[2].GetLiteralWord() == 0;
             case tosa::DataType::float16_t:
-                return instruction->m_Opcode == spv::OpTypeFloat && instruction->m_Operands[1].m_LiteralWord == 16;
+                return instruction->m_Opcode == spv::OpTypeFloat && instruction->m_Operands[1].GetLiteralWord() == 16;
             case tosa::DataType::float32_t:
-                return instruction->m_Opcode == spv::OpTypeFloat && instruction->m_Operands[1].m_LiteralWord == 32;
+                return instruction->m_Opcode == spv::OpTypeFloat && instruction->m_Operands[1].GetLiteralWord() == 32;
             case tosa::DataType::bfloat16_t:
-                return instruction->m_Opcode == spv::OpTypeFloat && instruction->m_Operands[1].m_LiteralWord == 16;
+                return instruction->m_Opcode == spv::OpTypeFloat && instruction->m_Operands[1].GetLiteralWord() == 16;
             case tosa::DataType::bool_t: return instruction->m_Opcode == spv::OpTypeBool;
             default: throw std::invalid_argument("Unhandled DataType in validation");
         }
@@ -87,19 +87,19 @@ void CheckDataType(const spirv::Instruction* instr, tosa::DataType expectedDataT
             << "  Expected: " << static_cast<int>(expectedDataType) << "\n"
             << "  Got Op:   " << static_cast<int>(instr->m_Opcode);
         if (operands.size() == 2)
-            oss << ", width=" << instr->m_Operands[1].m_LiteralWord;
+            oss << ", width=" << instr->m_Operands[1].GetLiteralWord();
         if (operands.size() == 3)
-            oss << ", qualifier=" << instr->m_Operands[2].m_LiteralWord;
+            oss << ", qualifier=" << instr->m_Operands[2].GetLiteralWord();
         throw std::invalid_argument(oss.str());
     }
 }
 
 void CheckResID(const spirv::Operand& operand)
 {
-    if (operand.m_Type != spirv::RES_ID || operand.m_LiteralWord == 0)
+    if (operand.GetType() != spirv::RES_ID || operand.GetLiteralWord() == 0)
     {
         std::ostringstream oss;
-        oss << "Invalid ResID: Type=" << operand.m_Type << ", Value=" << operand.m_LiteralWord;
+        oss << "Invalid ResID: Type=" << operand.GetType() << ", Value=" << operand.GetLiteralWord();
         throw std::invalid_argument(oss.str());
     }
 }
@@ -159,51 +159,51 @@ void CheckConstant(const spirv::Instruction* instruction,
 
     // ---- Operand type checks ----
     // Common first two operands: ResultType, ResultId
-    if (instruction->m_Operands[0].m_Type != spirv::INSTRUCTION_POINTER ||
-        instruction->m_Operands[1].m_Type != spirv::RES_ID)
+    if (instruction->m_Operands[0].GetType() != spirv::INSTRUCTION_POINTER ||
+        instruction->m_Operands[1].GetType() != spirv::RES_ID)
     {
         std::ostringstream oss;
         oss << "Invalid Constant Data (common operands). OpCode=" << opcode
-            << ", Operand[0] m_Type=" << instruction->m_Operands[0].m_Type
-            << ", Operand[1] m_Type=" << instruction->m_Operands[1].m_Type;
+            << ", Operand[0] m_Type=" << instruction->m_Operands[0].GetType()
+            << ", Operand[1] m_Type=" << instruction->m_Operands[1].GetType();
         throw std::invalid_argument(oss.str());
     }
 
     if (opcode == spv::OpConstant)
     {
-        if (instruction->m_Operands[2].m_Type != spirv::LITERAL_WORD ||
-            (isInt48 && instruction->m_Operands[3].m_Type != spirv::LITERAL_WORD))
+        if (instruction->m_Operands[2].GetType() != spirv::LITERAL_WORD ||
+            (isInt48 && instruction->m_Operands[3].GetType() != spirv::LITERAL_WORD))
         {
             std::ostringstream oss;
             oss << "Invalid Constant Data (literal operands). OpCode=" << opcode
-                << ", Operand[2] m_Type=" << instruction->m_Operands[2].m_Type;
+                << ", Operand[2] m_Type=" << instruction->m_Operands[2].GetType();
             if (isInt48)
-                oss << ", Operand[3] m_Type=" << instruction->m_Operands[3].m_Type;
+                oss << ", Operand[3] m_Type=" << instruction->m_Operands[3].GetType();
             throw std::invalid_argument(oss.str());
         }
     }
 
     // ---- Semantic checks shared by all constants ----
-    CheckDataType(instruction->m_Operands[0].m_InstructionPtr, expectedDataType);
+    CheckDataType(instruction->m_Operands[0].GetInstructionPtr(), expectedDataType);
     CheckResID(instruction->m_Operands[1]);
 
     // ---- Value checks ----
     if (opcode == spv::OpConstant)
     {
-        if (expectedValue0.has_value() && instruction->m_Operands[2].m_LiteralWord != expectedValue0.value())
+        if (expectedValue0.has_value() && instruction->m_Operands[2].GetLiteralWord() != expectedValue0.value())
         {
             std::ostringstream oss;
             oss << "Constant value mismatch (word0). Expected: " << expectedValue0.value()
-                << ", Got: " << instruction->m_Operands[2].m_LiteralWord;
+                << ", Got: " << instruction->m_Operands[2].GetLiteralWord();
             throw std::invalid_argument(oss.str());
         }
 
         // NOTE: fixed bug — check the second literal word (index 3) for int48_t.
-        if (isInt48 && expectedValue1.has_value() && instruction->m_Operands[3].m_LiteralWord != expectedValue1.value())
+        if (isInt48 && expectedValue1.has_value() && instruction->m_Operands[3].GetLiteralWord() != expectedValue1.value())
         {
             std::ostringstream oss;
             oss << "Constant value mismatch (word1). Expected: " << expectedValue1.value()
-                << ", Got: " << instruction->m_Operands[3].m_LiteralWord;
+                << ", Got: " << instruction->m_Operands[3].GetLiteralWord();
             throw std::invalid_argument(oss.str());
         }
     }
@@ -254,22 +254,22 @@ void CheckConstantComposite(const spirv::Instruction* instruction,
     const auto& typeOp = instruction->m_Operands[0];
     const auto& resId = instruction->m_Operands[1];
 
-    if (typeOp.m_Type != spirv::INSTRUCTION_POINTER || !typeOp.m_InstructionPtr)
+    if (typeOp.GetType() != spirv::INSTRUCTION_POINTER || !typeOp.GetInstructionPtr())
     {
         throw std::invalid_argument("Invalid or missing type in composite constant.");
     }
 
-    const spirv::Instruction* tensorTypeInstr = typeOp.m_InstructionPtr;
+    const spirv::Instruction* tensorTypeInstr = typeOp.GetInstructionPtr();
 
     if ((tensorTypeInstr->GetOpCode() == spv::OpTypeTensorARM || tensorTypeInstr->GetOpCode() == spv::OpTypeArray) &&
-        tensorTypeInstr->m_Operands[1].m_Type == spirv::INSTRUCTION_POINTER)
+        tensorTypeInstr->m_Operands[1].GetType() == spirv::INSTRUCTION_POINTER)
     {
-        const auto* elementType = tensorTypeInstr->m_Operands[1].m_InstructionPtr;
+        const auto* elementType = tensorTypeInstr->m_Operands[1].GetInstructionPtr();
         CheckDataType(elementType, expectedConstantType);
     }
     else
     {
-        CheckDataType(typeOp.m_InstructionPtr, expectedCompositeType);
+        CheckDataType(typeOp.GetInstructionPtr(), expectedCompositeType);
     }
 
     CheckResID(resId);
@@ -291,14 +291,14 @@ void CheckConstantComposite(const spirv::Instruction* instruction,
 
         const auto constantOp = instruction->m_Operands[base + i];
 
-        if (constantOp.m_Type != spirv::INSTRUCTION_POINTER || !constantOp.m_InstructionPtr)
+        if (constantOp.GetType() != spirv::INSTRUCTION_POINTER || !constantOp.GetInstructionPtr())
         {
             std::ostringstream oss;
             oss << "Invalid operand at index " << i << " in composite constant.";
             throw std::invalid_argument(oss.str());
         }
 
-        CheckConstant(constantOp.m_InstructionPtr, expectedConstantType, expectedValues[i]);
+        CheckConstant(constantOp.GetInstructionPtr(), expectedConstantType, expectedValues[i]);
     }
 }
 
@@ -317,27 +317,27 @@ void CheckTensorType(const spirv::Instruction* instruction,
     const auto& shapeOp = instruction->m_Operands[3];
 
     // DataType check
-    if (dataTypeOp.m_Type != spirv::INSTRUCTION_POINTER || !dataTypeOp.m_InstructionPtr)
+    if (dataTypeOp.GetType() != spirv::INSTRUCTION_POINTER || !dataTypeOp.GetInstructionPtr())
     {
         throw std::invalid_argument("Invalid data type operand in tensor: not an instruction pointer.");
     }
 
-    CheckDataType(dataTypeOp.m_InstructionPtr, expectedDataType);
+    CheckDataType(dataTypeOp.GetInstructionPtr(), expectedDataType);
 
     // Rank check
-    if (rankOp.m_Type != spirv::INSTRUCTION_POINTER || !rankOp.m_InstructionPtr)
+    if (rankOp.GetType() != spirv::INSTRUCTION_POINTER || !rankOp.GetInstructionPtr())
     {
         throw std::invalid_argument("Invalid rank operand in tensor: not an instruction pointer.");
     }
 
-    const auto* rankInstr = rankOp.m_InstructionPtr;
+    const auto* rankInstr = rankOp.GetInstructionPtr();
 
     if (rankInstr->GetOpCode() != spv::OpConstant || rankInstr->m_Operands.size() < 3)
     {
         throw std::invalid_argument("Rank operand is not a valid OpConstant.");
     }
 
-    const auto rankValue = rankInstr->m_Operands[2].m_LiteralWord;
+    const auto rankValue = rankInstr->m_Operands[2].GetLiteralWord();
     if (rankValue != expectedRank)
     {
         std::ostringstream oss;
@@ -345,10 +345,10 @@ void CheckTensorType(const spirv::Instruction* instruction,
         throw std::invalid_argument(oss.str());
     }
     // Shape check
-    if (shapeOp.m_Type != spirv::INSTRUCTION_POINTER || !shapeOp.m_InstructionPtr)
+    if (shapeOp.GetType() != spirv::INSTRUCTION_POINTER || !shapeOp.GetInstructionPtr())
     {
         throw std::invalid_argument("Invalid shape operand in tensor: not an instruction pointer.");
     }
     // Check constant composite inside shape
-    CheckConstantComposite(shapeOp.m_InstructionPtr, expectedShape, tosa::DataType::uint32_t, expectedDataType);
+    CheckConstantComposite(shapeOp.GetInstructionPtr(), expectedShape, tosa::DataType::uint32_t, expectedDataType);
 }
@@ -173,7 +173,8 @@ TEST(SpvUtilsTest, InstructionToStringBasic)
     instr.m_Opcode = spv::Op::OpConstant;
     instr.m_Operands.emplace_back(42);
 
-    instr.m_Operands.emplace_back("some_str");
+    const LiteralString someStr{"some_str"};
+    instr.m_Operands.emplace_back(&someStr);
     instr.m_Operands.emplace_back(123);
 
     std::string str = testutils::InstructionToString(instr);
@@ -186,7 +187,10 @@ TEST(SpvUtilsTest, InstructionToStringBasic)
 TEST(SpvUtilsTest, GetResId)
 {
     using namespace tfsc::spirv;
-    Instruction instr;
-    instr.m_Operands.emplace_back(123, RES_ID);
+    Instruction instr{spv::OpTypeInt, {Operand{123, RES_ID}}};
     EXPECT_EQ(GetResId(instr), 123);
+
+    instr.SetResId(456);
+    EXPECT_EQ(GetResId(instr), 456);
+    EXPECT_EQ(instr.m_Operands[0].GetLiteralWord(), 456);
 }
@@ -19,9 +19,7 @@ namespace testutils
 TEST(TestUtils, ResIdToString_ValidResId)
 {
     Instruction instr;
-    Operand op;
-    op.m_Type = RES_ID;
-    op.m_LiteralWord = 42;
+    Operand op{42, RES_ID};
     instr.m_Operands.push_back(op);
 
     EXPECT_EQ(testutils::ResIdToString(instr), "%42");
@@ -30,9 +28,7 @@ TEST(TestUtils, ResIdToString_ValidResId)
 TEST(TestUtils, ResIdToString_NoResId)
 {
     Instruction instr;
-    Operand op;
-    op.m_Type = LITERAL_WORD;
-    op.m_LiteralWord = 10;
+    Operand op{10, LITERAL_WORD};
     instr.m_Operands.push_back(op);
 
     EXPECT_EQ(testutils::ResIdToString(instr), "");
@@ -41,14 +37,10 @@ TEST(TestUtils, ResIdToString_NoResId)
 TEST(TestUtils, OperandToString_InstructionPointer)
 {
     Instruction instr;
-    Operand nested;
-    nested.m_Type = RES_ID;
-    nested.m_LiteralWord = 7;
+    Operand nested{7, RES_ID};
     instr.m_Operands.push_back(nested);
 
-    Operand op;
-    op.m_Type = INSTRUCTION_POINTER;
-    op.m_InstructionPtr = &instr;
+    Operand op{&instr};
 
     EXPECT_EQ(testutils::OperandToString(op), "%7");
 }
@@ -61,14 +53,15 @@ TEST(TestUtils, OperandToString_LiteralWord)
 
 TEST(TestUtils, OperandToString_LiteralString)
 {
-    Operand op{"hello"};
+    LiteralString hello{"hello"};
+    Operand op{&hello};
     EXPECT_EQ(testutils::OperandToString(op), "hello");
 }
 
 TEST(TestUtils, OperandToString_InvalidType)
 {
-    Operand op;
-    op.m_Type = static_cast<OperandType>(999);
+    // Operand types are stored in 3 bits, 7 is not a valid type
+    Operand op{0u, static_cast<OperandType>(7)};
     EXPECT_THROW(testutils::OperandToString(op), std::runtime_error);
 }
 
@@ -19,20 +19,20 @@ namespace tfsc::vgfwriter
 
 std::vector<int64_t> ExtractShapeFromTensor(const spirv::Instruction* tensorInstruction)
 {
-    const auto tensorShape = tensorInstruction->m_Operands[3].m_InstructionPtr;
+    const auto tensorShape = tensorInstruction->m_Operands[3].GetInstructionPtr();
 
     if (tensorShape->m_Opcode == spv::OpConstantCompositeReplicateEXT)
     {
-        const unsigned int value = tensorShape->m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord;
-        const auto array = tensorShape->m_Operands[0].m_InstructionPtr;
-        const unsigned int size = array->m_Operands[2].m_InstructionPtr->m_Operands[2].m_LiteralWord;
+        const unsigned int value = tensorShape->m_Operands[2].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
+        const auto array = tensorShape->m_Operands[0].GetInstructionPtr();
+        const unsigned int size = array->m_Operands[2].GetInstructionPtr()->m_Operands[2].GetLiteralWord();
         return std::vector<int64_t>(size, value);
     }
     std::vector<int64_t> shapeVector;
     for (auto operandIt = std::next(tensorShape->m_Operands.begin(), 2); operandIt != tensorShape->m_Operands.end();
          ++operandIt)
     {
-        shapeVector.push_back(operandIt->m_InstructionPtr->m_Operands[2].m_LiteralWord);
+        shapeVector.push_back(operandIt->GetInstructionPtr()->m_Operands[2].GetLiteralWord());
     }
     return shapeVector;
 }
@@ -40,10 +40,10 @@ std::vector<int64_t> ExtractShapeFromTensor(const spirv::Instruction* tensorInst
 static std::string GetVulkanFormatFromTensor(const spirv::Instruction* tensorInstruction)
 {
     using namespace spv;
-    const auto typeInstruction = tensorInstruction->m_Operands[1].m_InstructionPtr;
+    const auto typeInstruction = tensorInstruction->m_Operands[1].GetInstructionPtr();
 
     const Op& dataType = typeInstruction->m_Opcode;
-    const uint32_t rank = typeInstruction->m_Operands[1].m_LiteralWord;
+    const uint32_t rank = typeInstruction->m_Operands[1].GetLiteralWord();
     switch (dataType)
     {
         case OpTypeBool: return "VK_FORMAT_R8_BOOL_ARM";
@@ -84,7 +84,7 @@ std::vector<mlsdk::vgflib::ConstantRef> CollectConstants(mlsdk::vgflib::Encoder&
             continue;
         }
 
-        const auto tensor = it->m_Operands[0].m_InstructionPtr;
+        const auto tensor = it->m_Operands[0].GetInstructionPtr();
         auto tensorType = GetVulkanFormatFromTensor(tensor);
         std::vector<int64_t> constant_shape = ExtractShapeFromTensor(tensor);
 
@@ -128,15 +128,15 @@ void WriteVGF(std::shared_ptr<spirv::Module>& module,
     auto [decorateBegin, decorateEnd] = module->GetInstructionsOfType(spv::OpDecorate);
     for (auto it = decorateBegin; it != decorateEnd; ++it)
     {
-        if (it->m_Operands[1].m_LiteralWord != spv::DecorationBinding)
+        if (it->m_Operands[1].GetLiteralWord() != spv::DecorationBinding)
             continue;
 
-        const auto opVariable = it->m_Operands[0].m_InstructionPtr;
-        bindingMap.emplace(opVariable, it->m_Operands[2].m_LiteralWord);
+        const auto opVariable = it->m_Operands[0].GetInstructionPtr();
+        bindingMap.emplace(opVariable, it->m_Operands[2].GetLiteralWord());
     }
 
     auto graphType = module->GetInstructionsOfType(spv::OpTypeGraphARM).first;
-    const auto inputSize = graphType->m_Operands[1].m_LiteralWord;
+    const auto inputSize = graphType->m_Operands[1].GetLiteralWord();
 
     auto graphEntryPointInstruction = module->GetInstructionsOfType(spv::OpGraphEntryPointARM).first;
     const auto& entryPoints = graphEntryPointInstruction->m_Operands;
@@ -146,9 +146,9 @@ void WriteVGF(std::shared_ptr<spirv::Module>& module,
 
     for (; inputBegin < inputEnd; ++inputBegin)
     {
-        const auto inputOpVariable = inputBegin->m_InstructionPtr;
-        const auto uniformConstantPtr = inputOpVariable->m_Operands[0].m_InstructionPtr;
-        const auto inputTensor = uniformConstantPtr->m_Operands[2].m_InstructionPtr;
+        const auto inputOpVariable = inputBegin->GetInstructionPtr();
+        const auto uniformConstantPtr = inputOpVariable->m_Operands[0].GetInstructionPtr();
+        const auto inputTensor = uniformConstantPtr->m_Operands[2].GetInstructionPtr();
 
         auto tensorType = GetVulkanFormatFromTensor(inputTensor);
         std::vector<int64_t> shape = ExtractShapeFromTensor(inputTensor);
@@ -167,9 +167,9 @@ void WriteVGF(std::shared_ptr<spirv::Module>& module,
 
     for (auto outputBegin = inputBegin; outputBegin < entryPoints.end(); ++outputBegin)
     {
-        const auto outputOpVariable = outputBegin->m_InstructionPtr;
-        const auto uniformConstantPtr = outputOpVariable->m_Operands[0].m_InstructionPtr;
-        const auto outputTensor = uniformConstantPtr->m_Operands[2].m_InstructionPtr;
+        const auto outputOpVariable = outputBegin->GetInstructionPtr();
+        const auto uniformConstantPtr = outputOpVariable->m_Operands[0].GetInstructionPtr();
+        const auto outputTensor = uniformConstantPtr->m_Operands[2].GetInstructionPtr();
 
         auto tensorType = GetVulkanFormatFromTensor(outputTensor);
         std::vector<int64_t> shape = ExtractShapeFromTensor(outputTensor);